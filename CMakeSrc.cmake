@@ -2,20 +2,72 @@
 set(SOURCE_FILES_LINKED
 ${SourcePath}/linked_ptr.h
 ${SourcePath}/linked_ptr.hpp
+${SourcePath}/counted_linked_ptr.h
+${SourcePath}/counted_linked_ptr.hpp
+${SourcePath}/concurrent_linked_ptr.h
+${SourcePath}/concurrent_linked_ptr.hpp
+${SourcePath}/intrusive_linked_ptr.h
+${SourcePath}/intrusive_linked_ptr.hpp
+${SourcePath}/compact_linked_ptr.h
+${SourcePath}/compact_linked_ptr.hpp
+${SourcePath}/reclamation_queue.h
+${SourcePath}/reclamation_queue.hpp
+${SourcePath}/epoch_publisher.h
+${SourcePath}/epoch_publisher.hpp
+${SourcePath}/atomic_linked_ptr.h
+${SourcePath}/atomic_linked_ptr.hpp
+${SourcePath}/linked_buffer.h
+${SourcePath}/linked_buffer.hpp
+${SourcePath}/biased_linked_ptr.h
+${SourcePath}/biased_linked_ptr.hpp
+${SourcePath}/linked_flat_table.h
+${SourcePath}/linked_flat_table.hpp
 )
 
 set(SOURCE_FILES_TEST
 ${TestPath}/TestObject.h
 ${TestPath}/general_tests.h
+${TestPath}/handle_tests.h
+${TestPath}/counted_tests.h
+${TestPath}/concurrent_tests.h
+${TestPath}/intrusive_tests.h
+${TestPath}/compact_tests.h
+${TestPath}/reclamation_tests.h
+${TestPath}/epoch_tests.h
+${TestPath}/atomic_tests.h
+${TestPath}/buffer_tests.h
+${TestPath}/biased_tests.h
+${TestPath}/flat_tests.h
 ${TestPath}/main.cpp
 )
 
+set(SOURCE_FILES_BENCH
+${BenchPath}/general_bench.h
+${BenchPath}/concurrent_bench.h
+${BenchPath}/intrusive_bench.h
+${BenchPath}/compact_bench.h
+${BenchPath}/reclamation_bench.h
+${BenchPath}/epoch_bench.h
+${BenchPath}/atomic_bench.h
+${BenchPath}/buffer_bench.h
+${BenchPath}/biased_bench.h
+${BenchPath}/flat_bench.h
+${BenchPath}/main.cpp
+)
+
 # set appropriate source groups
 source_group(linked_ptr  FILES  ${SOURCE_FILES_LINKED})
 source_group(test  FILES  ${SOURCE_FILES_TEST})
+source_group(bench  FILES  ${SOURCE_FILES_BENCH})
 
 # set all source files
 set(SOURCE_FILES
 ${SOURCE_FILES_LINKED}
 ${SOURCE_FILES_TEST}
+)
+
+# benchmark source files
+set(BENCH_SOURCE_FILES
+${SOURCE_FILES_LINKED}
+${SOURCE_FILES_BENCH}
 )
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef BENCH_SMART_POINTERS_ATOMIC_BENCH_H
+#define BENCH_SMART_POINTERS_ATOMIC_BENCH_H
+
+#include <atomic>
+#include <memory>
+#include "benchmark/benchmark.h"
+#include "atomic_linked_ptr.h"
+#include "concurrent_bench.h"
+
+    // std::atomic<std::shared_ptr> where the library has it,
+    // the atomic_load/atomic_store overloads otherwise
+#if defined(__cpp_lib_atomic_shared_ptr)
+typedef std::atomic<std::shared_ptr<BenchObject>> shared_slot;
+#else
+struct shared_slot
+{
+    typedef std::shared_ptr<BenchObject> value_type;
+
+    shared_slot(value_type const& desired)
+        : value(desired)
+    {
+    }
+    value_type load() const
+    {
+        return std::atomic_load(&value);
+    }
+    void store(value_type desired)
+    {
+        std::atomic_store(&value, std::move(desired));
+    }
+
+    value_type value;
+};
+#endif
+
+    // the first thread keeps publishing new objects,
+    // all the others load the current one and read it
+template<class Slot>
+void BM_PublishRead(benchmark::State& state)
+{
+    typedef typename Slot::value_type value_type;
+    static Slot slot(bench_traits<value_type>::make(0));
+    int version = 0;
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+        {
+            slot.store(bench_traits<value_type>::make(++version));
+        }
+        else
+        {
+            value_type current = slot.load();
+            benchmark::DoNotOptimize(current->value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_PublishRead, atomic_linked_ptr<BenchObject, mutex_pool<>>)->ThreadRange(2, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PublishRead, atomic_linked_ptr<BenchObject, spinlock_pool<>>)->ThreadRange(2, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PublishRead, shared_slot)->ThreadRange(2, 64)->UseRealTime();
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef BENCH_SMART_POINTERS_BIASED_BENCH_H
+#define BENCH_SMART_POINTERS_BIASED_BENCH_H
+
+#include <thread>
+#include "benchmark/benchmark.h"
+#include "biased_linked_ptr.h"
+#include "concurrent_bench.h"
+
+template<>
+struct bench_traits<biased_linked_ptr<BenchObject>>
+{
+    static biased_linked_ptr<BenchObject> make(int value)
+    {
+        return make_biased_linked<BenchObject>(value);
+    }
+};
+
+    // handle that may be released on another thread than its own
+template<class P>
+P share_handle(P const& ptr)
+{
+    return ptr;
+}
+
+inline biased_linked_ptr<BenchObject> share_handle(biased_linked_ptr<BenchObject> const& ptr)
+{
+    return ptr.share();
+}
+
+    // biased handles against the same ring locked for every splice
+#define BIASED_PTR_BENCH(func) \
+    BENCHMARK_TEMPLATE(func, biased_linked_ptr<BenchObject>); \
+    BENCHMARK_TEMPLATE(func, concurrent_linked_ptr<BenchObject, spinlock_pool<>>)
+
+    // copies on the thread that made the object
+template<class P>
+void BM_OwnerThreadCopy(benchmark::State& state)
+{
+    P const source = bench_traits<P>::make(0);
+    P local[4] = { source, source, source, source };
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        P copy(local[i++ % 4]);
+        benchmark::DoNotOptimize(copy.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BIASED_PTR_BENCH(BM_OwnerThreadCopy);
+
+    // copies on a thread that didn't make the object
+template<class P>
+void BM_OtherThreadCopy(benchmark::State& state)
+{
+    P source;
+    std::thread([&source]() { source = share_handle(bench_traits<P>::make(0)); }).join();
+    P local[4] = { source, source, source, source };
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        P copy(local[i++ % 4]);
+        benchmark::DoNotOptimize(copy.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BIASED_PTR_BENCH(BM_OtherThreadCopy);
+
+#endif
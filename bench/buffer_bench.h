@@ -0,0 +1,51 @@
+#ifndef BENCH_SMART_POINTERS_BUFFER_BENCH_H
+#define BENCH_SMART_POINTERS_BUFFER_BENCH_H
+
+#include <string>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "linked_buffer.h"
+
+    // a 64 KB packet parsed into fields of range(0) bytes
+template<class Field>
+struct field_parser;
+
+template<>
+struct field_parser<linked_buffer>
+{
+    static linked_buffer parse(linked_buffer const& packet, std::size_t offset, std::size_t length)
+    {
+        return packet.slice(offset, length);
+    }
+};
+
+template<>
+struct field_parser<std::string>
+{
+    static std::string parse(linked_buffer const& packet, std::size_t offset, std::size_t length)
+    {
+        return std::string(packet.data() + offset, length);
+    }
+};
+
+template<class Field>
+void BM_ParsePacket(benchmark::State& state)
+{
+    std::size_t const PACKET_SIZE = 64 * 1024;
+    std::size_t const fieldSize = static_cast<std::size_t>(state.range(0));
+    linked_buffer packet(PACKET_SIZE);
+    std::vector<Field> fields;
+    fields.reserve(PACKET_SIZE / fieldSize);
+    for (auto _ : state)
+    {
+        for (std::size_t offset = 0; offset < PACKET_SIZE; offset += fieldSize)
+            fields.push_back(field_parser<Field>::parse(packet, offset, fieldSize));
+        benchmark::DoNotOptimize(fields.data());
+        fields.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(PACKET_SIZE / fieldSize));
+}
+BENCHMARK_TEMPLATE(BM_ParsePacket, linked_buffer)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_ParsePacket, std::string)->RangeMultiplier(8)->Range(8, 4096);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef BENCH_SMART_POINTERS_COMPACT_BENCH_H
+#define BENCH_SMART_POINTERS_COMPACT_BENCH_H
+
+#include "benchmark/benchmark.h"
+#include "compact_linked_ptr.h"
+#include "general_bench.h"
+
+template<>
+struct bench_traits<compact_linked_ptr<BenchObject>>
+{
+    static compact_linked_ptr<BenchObject> make(int value)
+    {
+        return make_compact_linked<BenchObject>(value);
+    }
+};
+
+#define COMPACT_PTR_BENCH(func) \
+    BENCHMARK_TEMPLATE(func, compact_linked_ptr<BenchObject>)->RangeMultiplier(10)->Range(1, 100000)
+
+COMPACT_PTR_BENCH(BM_Copy);
+COMPACT_PTR_BENCH(BM_VectorGrowth);
+COMPACT_PTR_BENCH(BM_Reset);
+COMPACT_PTR_BENCH(BM_VectorGrowthUnique);
+COMPACT_PTR_BENCH(BM_Iterate);
+COMPACT_PTR_BENCH(BM_SetInsertErase);
+
+#endif
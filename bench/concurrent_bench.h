@@ -0,0 +1,61 @@
+#ifndef BENCH_SMART_POINTERS_CONCURRENT_BENCH_H
+#define BENCH_SMART_POINTERS_CONCURRENT_BENCH_H
+
+#include <memory>
+#include "benchmark/benchmark.h"
+#include "concurrent_linked_ptr.h"
+#include "general_bench.h"
+
+    // all threads copy and drop handles of one object,
+    // so they all contend for the same ring
+#define CONCURRENT_PTR_BENCH(func) \
+    BENCHMARK_TEMPLATE(func, concurrent_linked_ptr<BenchObject, mutex_pool<>>)->ThreadRange(1, 64)->UseRealTime(); \
+    BENCHMARK_TEMPLATE(func, concurrent_linked_ptr<BenchObject, spinlock_pool<>>)->ThreadRange(1, 64)->UseRealTime(); \
+    BENCHMARK_TEMPLATE(func, std::shared_ptr<BenchObject>)->ThreadRange(1, 64)->UseRealTime()
+
+template<class LockPool>
+struct bench_traits<concurrent_linked_ptr<BenchObject, LockPool>>
+{
+    static concurrent_linked_ptr<BenchObject, LockPool> make(int value)
+    {
+        return make_concurrent_linked<BenchObject, LockPool>(value);
+    }
+};
+
+template<class P>
+P& shared_bench_object()
+{
+    static P ptr = bench_traits<P>::make(0);
+    return ptr;
+}
+
+template<class P>
+void BM_ContendedCopy(benchmark::State& state)
+{
+    P const& shared = shared_bench_object<P>();
+    for (auto _ : state)
+    {
+        P copy(shared);
+        benchmark::DoNotOptimize(copy.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+CONCURRENT_PTR_BENCH(BM_ContendedCopy);
+
+    // every thread keeps a few handles of its own, copies among them
+    // still splice the shared ring
+template<class P>
+void BM_ContendedLocalCopy(benchmark::State& state)
+{
+    P local[4] = { shared_bench_object<P>(), shared_bench_object<P>(), shared_bench_object<P>(), shared_bench_object<P>() };
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        P copy(local[i++ % 4]);
+        benchmark::DoNotOptimize(copy.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+CONCURRENT_PTR_BENCH(BM_ContendedLocalCopy);
+
+#endif
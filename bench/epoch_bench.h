@@ -0,0 +1,38 @@
+#ifndef BENCH_SMART_POINTERS_EPOCH_BENCH_H
+#define BENCH_SMART_POINTERS_EPOCH_BENCH_H
+
+#include "benchmark/benchmark.h"
+#include "concurrent_linked_ptr.h"
+#include "epoch_publisher.h"
+#include "general_bench.h"
+
+    // readers look at the published object under an epoch guard,
+    // none of them touches its ring
+void BM_EpochRead(benchmark::State& state)
+{
+    static epoch_domain domain;
+    static epoch_publisher<BenchObject const> publisher(domain, make_linked<BenchObject const>(0));
+    for (auto _ : state)
+    {
+        epoch_guard guard(domain);
+        benchmark::DoNotOptimize(publisher.read(guard)->value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EpochRead)->ThreadRange(1, 64)->UseRealTime();
+
+    // readers copy the handle to read the object
+template<class P>
+void BM_CopyToRead(benchmark::State& state)
+{
+    P const& shared = shared_bench_object<P>();
+    for (auto _ : state)
+    {
+        P copy(shared);
+        benchmark::DoNotOptimize(copy->value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+CONCURRENT_PTR_BENCH(BM_CopyToRead);
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef BENCH_SMART_POINTERS_FLAT_BENCH_H
+#define BENCH_SMART_POINTERS_FLAT_BENCH_H
+
+#include <set>
+#include <unordered_set>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "linked_flat_table.h"
+#include "general_bench.h"
+
+    // node based containers against the flat table, all of them
+    // holding a second owner of every object
+#define LINKED_TABLE_BENCH(func) \
+    BENCHMARK_TEMPLATE(func, std::set<linked_ptr<BenchObject>, linked_ptr_less>)->RangeMultiplier(10)->Range(100, 100000); \
+    BENCHMARK_TEMPLATE(func, std::unordered_set<linked_ptr<BenchObject>>)->RangeMultiplier(10)->Range(100, 100000); \
+    BENCHMARK_TEMPLATE(func, linked_ptr_flat_set<BenchObject>)->RangeMultiplier(10)->Range(100, 100000)
+
+template<class Table>
+void BM_TableInsertErase(benchmark::State& state)
+{
+    std::vector<linked_ptr<BenchObject>> objects;
+    for (long i = 0; i < state.range(0); ++i)
+        objects.push_back(make_linked<BenchObject>(static_cast<int>(i)));
+    for (auto _ : state)
+    {
+        Table table;
+        for (linked_ptr<BenchObject> const& ptr : objects)
+            table.insert(ptr);
+        for (linked_ptr<BenchObject> const& ptr : objects)
+            table.erase(ptr);
+        benchmark::DoNotOptimize(table.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+LINKED_TABLE_BENCH(BM_TableInsertErase);
+
+template<class Table>
+void BM_TableFind(benchmark::State& state)
+{
+    std::vector<linked_ptr<BenchObject>> objects;
+    for (long i = 0; i < state.range(0); ++i)
+        objects.push_back(make_linked<BenchObject>(static_cast<int>(i)));
+    Table table;
+    for (linked_ptr<BenchObject> const& ptr : objects)
+        table.insert(ptr);
+    std::shuffle(objects.begin(), objects.end(), std::mt19937(42));
+    for (auto _ : state)
+    {
+        for (linked_ptr<BenchObject> const& ptr : objects)
+            benchmark::DoNotOptimize(table.find(ptr) != table.end());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+LINKED_TABLE_BENCH(BM_TableFind);
+
+#endif
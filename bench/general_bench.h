@@ -0,0 +1,367 @@
+#ifndef BENCH_SMART_POINTERS_GENERAL_BENCH_H
+#define BENCH_SMART_POINTERS_GENERAL_BENCH_H
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "linked_ptr.h"
+
+    // every benchmark is run for the pointer types below
+    // with 1..100k owners of the measured object
+#define SMART_PTR_BENCH(func) \
+    BENCHMARK_TEMPLATE(func, linked_ptr<BenchObject>)->RangeMultiplier(10)->Range(1, 100000); \
+    BENCHMARK_TEMPLATE(func, std::shared_ptr<BenchObject>)->RangeMultiplier(10)->Range(1, 100000)
+
+struct BenchObject
+{
+    BenchObject(int v)
+        : value(v)
+    {
+    }
+    int value;
+};
+
+template<class P>
+struct bench_traits;
+
+template<>
+struct bench_traits<linked_ptr<BenchObject>>
+{
+    static linked_ptr<BenchObject> make(int value)
+    {
+        return make_linked<BenchObject>(value);
+    }
+};
+
+template<>
+struct bench_traits<std::shared_ptr<BenchObject>>
+{
+    static std::shared_ptr<BenchObject> make(int value)
+    {
+        return std::make_shared<BenchObject>(value);
+    }
+};
+
+template<>
+struct bench_traits<std::unique_ptr<BenchObject>>
+{
+    static std::unique_ptr<BenchObject> make(int value)
+    {
+        return std::unique_ptr<BenchObject>(new BenchObject(value));
+    }
+};
+
+    // pointer to a fresh object together with (owners - 1) copies of it
+template<class P>
+struct owned_object
+{
+    owned_object(benchmark::State const& state)
+        : ptr(bench_traits<P>::make(0))
+        , owners(static_cast<size_t>(state.range(0) - 1), ptr)
+    {
+    }
+
+    P ptr;
+    std::vector<P> owners;
+};
+
+template<class P>
+void BM_Copy(benchmark::State& state)
+{
+    owned_object<P> obj(state);
+    for (auto _ : state)
+    {
+        P copy(obj.ptr);
+        benchmark::DoNotOptimize(copy.get());
+    }
+}
+SMART_PTR_BENCH(BM_Copy);
+
+template<class P>
+void BM_Move(benchmark::State& state)
+{
+    owned_object<P> obj(state);
+    P other;
+    for (auto _ : state)
+    {
+        other = std::move(obj.ptr);
+        obj.ptr = std::move(other);
+        benchmark::DoNotOptimize(obj.ptr.get());
+    }
+}
+SMART_PTR_BENCH(BM_Move);
+
+template<class P>
+void BM_Reset(benchmark::State& state)
+{
+    owned_object<P> obj(state);
+    for (auto _ : state)
+    {
+        P copy(obj.ptr);
+        copy.reset();
+        benchmark::DoNotOptimize(copy.get());
+    }
+}
+SMART_PTR_BENCH(BM_Reset);
+
+template<class P>
+void BM_Destruction(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        owned_object<P>* obj = new owned_object<P>(state);
+        state.ResumeTiming();
+        delete obj;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+SMART_PTR_BENCH(BM_Destruction);
+
+template<class P>
+void BM_UseCount(benchmark::State& state)
+{
+    owned_object<P> obj(state);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(obj.ptr.use_count());
+    }
+}
+SMART_PTR_BENCH(BM_UseCount);
+
+template<class P>
+void BM_Swap(benchmark::State& state)
+{
+    owned_object<P> first(state);
+    owned_object<P> second(state);
+    for (auto _ : state)
+    {
+        first.ptr.swap(second.ptr);
+        benchmark::DoNotOptimize(first.ptr.get());
+    }
+}
+SMART_PTR_BENCH(BM_Swap);
+
+template<class P>
+void BM_Make(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        P ptr = bench_traits<P>::make(0);
+        benchmark::DoNotOptimize(ptr.get());
+    }
+}
+BENCHMARK_TEMPLATE(BM_Make, linked_ptr<BenchObject>);
+BENCHMARK_TEMPLATE(BM_Make, std::shared_ptr<BenchObject>);
+BENCHMARK_TEMPLATE(BM_Make, std::unique_ptr<BenchObject>);
+
+    // vector grows one push_back at a time, every copy joins the ring
+template<class P>
+void BM_VectorGrowth(benchmark::State& state)
+{
+    P ptr = bench_traits<P>::make(0);
+    for (auto _ : state)
+    {
+        std::vector<P> vec;
+        for (long i = 0; i < state.range(0); ++i)
+            vec.push_back(ptr);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+SMART_PTR_BENCH(BM_VectorGrowth);
+
+template<class P>
+void BM_VectorGrowthUnique(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::vector<P> vec;
+        for (long i = 0; i < state.range(0); ++i)
+            vec.push_back(bench_traits<P>::make(static_cast<int>(i)));
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_VectorGrowthUnique, linked_ptr<BenchObject>)->RangeMultiplier(10)->Range(1, 100000);
+BENCHMARK_TEMPLATE(BM_VectorGrowthUnique, std::shared_ptr<BenchObject>)->RangeMultiplier(10)->Range(1, 100000);
+BENCHMARK_TEMPLATE(BM_VectorGrowthUnique, std::unique_ptr<BenchObject>)->RangeMultiplier(10)->Range(1, 100000);
+
+    // walks a vector of distinct objects, the handles are streamed
+    // through the cache together with the objects they point to
+template<class P>
+void BM_Iterate(benchmark::State& state)
+{
+    std::vector<P> vec;
+    for (long i = 0; i < state.range(0); ++i)
+        vec.push_back(bench_traits<P>::make(static_cast<int>(i)));
+    for (auto _ : state)
+    {
+        long sum = 0;
+        for (P const& ptr : vec)
+            sum += ptr->value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<long>(sizeof(P)));
+}
+SMART_PTR_BENCH(BM_Iterate);
+
+    // sorts shuffled distinct objects by value,
+    // std::sort moves and swaps the handles all the time
+template<class P>
+void BM_Sort(benchmark::State& state)
+{
+    std::vector<P> vec;
+    for (long i = 0; i < state.range(0); ++i)
+        vec.push_back(bench_traits<P>::make(static_cast<int>(i)));
+    std::mt19937 random(42);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::shuffle(vec.begin(), vec.end(), random);
+        state.ResumeTiming();
+        std::sort(vec.begin(), vec.end(), [](P const& left, P const& right)
+        {
+            return left->value < right->value;
+        });
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+SMART_PTR_BENCH(BM_Sort);
+
+    // vector of range(0) handles, every range(1) of them share an object.
+    // The owners of an object are scattered over the whole vector
+template<class P>
+std::vector<P> make_handles(benchmark::State const& state)
+{
+    long const objects = state.range(0) / state.range(1);
+    std::vector<P> vec;
+    vec.reserve(static_cast<size_t>(state.range(0)));
+    for (long i = 0; i < state.range(0); ++i)
+    {
+        if (i < objects)
+            vec.push_back(bench_traits<P>::make(static_cast<int>(i)));
+        else
+            vec.push_back(vec[static_cast<size_t>(i % objects)]);
+    }
+    std::shuffle(vec.begin(), vec.end(), std::mt19937(42));
+    return vec;
+}
+
+template<class P>
+void BM_ClearVector(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<P> vec = make_handles<P>(state);
+        state.ResumeTiming();
+        vec.clear();
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_ClearVector, linked_ptr<BenchObject>)->Ranges({ { 1000, 1000000 }, { 1, 1000 } });
+BENCHMARK_TEMPLATE(BM_ClearVector, std::shared_ptr<BenchObject>)->Ranges({ { 1000, 1000000 }, { 1, 1000 } });
+
+void BM_DestroyRange(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<linked_ptr<BenchObject>> vec = make_handles<linked_ptr<BenchObject>>(state);
+        state.ResumeTiming();
+        destroy_range(vec.data(), vec.data() + vec.size());
+        vec.clear();
+        benchmark::DoNotOptimize(vec.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DestroyRange)->Ranges({ { 1000, 1000000 }, { 1, 1000 } });
+
+    // set holds a copy of every object, so each insert and erase
+    // splices a ring of two owners
+template<class P>
+void BM_SetInsertErase(benchmark::State& state)
+{
+    std::vector<P> objects;
+    for (long i = 0; i < state.range(0); ++i)
+        objects.push_back(bench_traits<P>::make(static_cast<int>(i)));
+    for (auto _ : state)
+    {
+        std::set<P> set;
+        for (P const& ptr : objects)
+            set.insert(ptr);
+        for (P const& ptr : objects)
+            set.erase(ptr);
+        benchmark::DoNotOptimize(set.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+SMART_PTR_BENCH(BM_SetInsertErase);
+
+    // looks every object up by its raw pointer: through a temporary
+    // handle with std::less, directly with linked_ptr_less
+template<class Less>
+struct lookup_key
+{
+    static linked_ptr<BenchObject> make(linked_ptr<BenchObject> const& ptr)
+    {
+        return ptr;
+    }
+};
+
+template<>
+struct lookup_key<linked_ptr_less>
+{
+    static BenchObject const* make(linked_ptr<BenchObject> const& ptr)
+    {
+        return ptr.get();
+    }
+};
+
+template<class Less>
+void BM_SetFindByPointer(benchmark::State& state)
+{
+    std::vector<linked_ptr<BenchObject>> objects = make_handles<linked_ptr<BenchObject>>(state);
+    std::set<linked_ptr<BenchObject>, Less> set(objects.begin(), objects.end());
+    for (auto _ : state)
+    {
+        for (linked_ptr<BenchObject> const& ptr : objects)
+            benchmark::DoNotOptimize(set.find(lookup_key<Less>::make(ptr)));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_SetFindByPointer, std::less<linked_ptr<BenchObject>>)->Ranges({ { 1000, 100000 }, { 1, 1 } });
+BENCHMARK_TEMPLATE(BM_SetFindByPointer, linked_ptr_less)->Ranges({ { 1000, 100000 }, { 1, 1 } });
+
+    // the object goes down a chain of range(0) calls, each stage
+    // taking its parameter by value
+template<class Param>
+int pass_down(Param object, long depth)
+{
+    benchmark::DoNotOptimize(object.get());
+    if (depth == 0)
+        return object->value;
+    return pass_down<Param>(object, depth - 1);
+}
+
+template<class Param>
+void BM_PassDown(benchmark::State& state)
+{
+    linked_ptr<BenchObject> object = make_linked<BenchObject>(1);
+        // a few more owners, as the object would have in a real pipeline
+    std::vector<linked_ptr<BenchObject>> owners(16, object);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(pass_down<Param>(object, state.range(0)));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_PassDown, linked_ptr<BenchObject>)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK_TEMPLATE(BM_PassDown, borrowed_linked_ptr<BenchObject>)->RangeMultiplier(4)->Range(1, 64);
+
+#endif
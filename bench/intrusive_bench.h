@@ -0,0 +1,36 @@
+#ifndef BENCH_SMART_POINTERS_INTRUSIVE_BENCH_H
+#define BENCH_SMART_POINTERS_INTRUSIVE_BENCH_H
+
+#include "benchmark/benchmark.h"
+#include "intrusive_linked_ptr.h"
+#include "general_bench.h"
+
+struct HookedBenchObject : public BenchObject, public linked_hook
+{
+    HookedBenchObject(int v)
+        : BenchObject(v)
+    {
+    }
+};
+
+template<>
+struct bench_traits<intrusive_linked_ptr<HookedBenchObject>>
+{
+    static intrusive_linked_ptr<HookedBenchObject> make(int value)
+    {
+        return make_intrusive_linked<HookedBenchObject>(value);
+    }
+};
+
+#define INTRUSIVE_PTR_BENCH(func) \
+    BENCHMARK_TEMPLATE(func, intrusive_linked_ptr<HookedBenchObject>)->RangeMultiplier(10)->Range(1, 100000)
+
+INTRUSIVE_PTR_BENCH(BM_Copy);
+INTRUSIVE_PTR_BENCH(BM_Reset);
+INTRUSIVE_PTR_BENCH(BM_Destruction);
+INTRUSIVE_PTR_BENCH(BM_VectorGrowth);
+INTRUSIVE_PTR_BENCH(BM_VectorGrowthUnique);
+INTRUSIVE_PTR_BENCH(BM_Iterate);
+INTRUSIVE_PTR_BENCH(BM_SetInsertErase);
+
+#endif
@@ -0,0 +1,13 @@
+#include "benchmark/benchmark.h"
+#include "general_bench.h"
+#include "concurrent_bench.h"
+#include "intrusive_bench.h"
+#include "compact_bench.h"
+#include "reclamation_bench.h"
+#include "epoch_bench.h"
+#include "atomic_bench.h"
+#include "buffer_bench.h"
+#include "biased_bench.h"
+#include "flat_bench.h"
+
+BENCHMARK_MAIN();
@@ -0,0 +1,41 @@
+#ifndef BENCH_SMART_POINTERS_RECLAMATION_BENCH_H
+#define BENCH_SMART_POINTERS_RECLAMATION_BENCH_H
+
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "linked_ptr.h"
+#include "reclamation_queue.h"
+#include "general_bench.h"
+
+    // object that takes down range(0) others with it
+struct BenchGraph
+{
+    std::vector<linked_ptr<BenchObject>> children;
+};
+
+    // time the thread dropping the last owner of the graph spends in reset()
+template<bool Deferred>
+void BM_LastOwnerReset(benchmark::State& state)
+{
+    reclamation_queue queue(1 << 16);
+    queue.start();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        linked_ptr<BenchGraph> graph = Deferred
+            ? linked_ptr<BenchGraph>(new BenchGraph, deferred_delete<BenchGraph>(queue))
+            : linked_ptr<BenchGraph>(new BenchGraph);
+        for (long i = 0; i < state.range(0); ++i)
+            graph->children.push_back(make_linked<BenchObject>(static_cast<int>(i)));
+        state.ResumeTiming();
+        graph.reset();
+    }
+    queue.stop();
+    reclamation_stats const stats = queue.stats();
+    state.counters["peak_depth"] = static_cast<double>(stats.peakDepth);
+    state.counters["longest_drain_us"] = static_cast<double>(stats.longestDrain.count()) / 1000.0;
+}
+BENCHMARK_TEMPLATE(BM_LastOwnerReset, false)->RangeMultiplier(10)->Range(1, 100000);
+BENCHMARK_TEMPLATE(BM_LastOwnerReset, true)->RangeMultiplier(10)->Range(1, 100000);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef SMART_POINTERS_ATOMIC_LINKED_PTR_H
+#define SMART_POINTERS_ATOMIC_LINKED_PTR_H
+#include "concurrent_linked_ptr.h"
+
+
+    // slot holding a concurrent_linked_ptr that may be read and replaced
+    // from different threads, same operations as std::atomic.
+    // The slot has its own spinlock, the values handed out are ordinary
+    // concurrent_linked_ptr's. A replaced value is released after
+    // the slot is unlocked
+template<class T, class LockPool = mutex_pool<>>
+class atomic_linked_ptr
+{
+public:
+    typedef concurrent_linked_ptr<T, LockPool> value_type;
+
+    atomic_linked_ptr();
+    atomic_linked_ptr(value_type const& desired);
+
+    atomic_linked_ptr(atomic_linked_ptr<T, LockPool> const&) = delete;
+    atomic_linked_ptr<T, LockPool>& operator=(atomic_linked_ptr<T, LockPool> const&) = delete;
+
+    value_type load() const;
+    void store(value_type desired);
+    value_type exchange(value_type desired);
+
+        // succeeds when the slot points to the same object as expected,
+        // otherwise expected gets the current value
+    bool compare_exchange_strong(value_type& expected, value_type desired);
+    bool compare_exchange_weak(value_type& expected, value_type desired);
+
+    bool is_lock_free() const;
+
+    operator value_type() const;
+    atomic_linked_ptr<T, LockPool>& operator=(value_type desired);
+
+private:
+    mutable spinlock mLock;
+    value_type mValue;
+};
+
+#include "atomic_linked_ptr.hpp"
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef SMART_POINTERS_ATOMIC_LINKED_PTR_CPP
+#define SMART_POINTERS_ATOMIC_LINKED_PTR_CPP
+
+#include <mutex> // for lock_guard
+
+/*********************************************************/
+/*                   atomic_linked_ptr                   */
+
+template<class T, class LockPool>
+atomic_linked_ptr<T, LockPool>::atomic_linked_ptr()
+{
+}
+
+template<class T, class LockPool>
+atomic_linked_ptr<T, LockPool>::atomic_linked_ptr(value_type const& desired)
+    : mValue(desired)
+{
+}
+
+template<class T, class LockPool>
+typename atomic_linked_ptr<T, LockPool>::value_type atomic_linked_ptr<T, LockPool>::load() const
+{
+    std::lock_guard<spinlock> guard(mLock);
+    return mValue;
+}
+
+template<class T, class LockPool>
+void atomic_linked_ptr<T, LockPool>::store(value_type desired)
+{
+    exchange(std::move(desired));
+}
+
+template<class T, class LockPool>
+typename atomic_linked_ptr<T, LockPool>::value_type atomic_linked_ptr<T, LockPool>::exchange(value_type desired)
+{
+    {
+        std::lock_guard<spinlock> guard(mLock);
+        mValue.swap(desired);
+    }
+    return desired;
+}
+
+template<class T, class LockPool>
+bool atomic_linked_ptr<T, LockPool>::compare_exchange_strong(value_type& expected, value_type desired)
+{
+    value_type current;
+    {
+        std::lock_guard<spinlock> guard(mLock);
+        if (mValue.get() == expected.get())
+        {
+            mValue.swap(desired);
+            return true;
+        }
+        value_type(mValue).swap(current);
+    }
+        // the old expected is released outside of the lock
+    expected.swap(current);
+    return false;
+}
+
+template<class T, class LockPool>
+bool atomic_linked_ptr<T, LockPool>::compare_exchange_weak(value_type& expected, value_type desired)
+{
+    return compare_exchange_strong(expected, std::move(desired));
+}
+
+template<class T, class LockPool>
+bool atomic_linked_ptr<T, LockPool>::is_lock_free() const
+{
+    return false;
+}
+
+template<class T, class LockPool>
+atomic_linked_ptr<T, LockPool>::operator value_type() const
+{
+    return load();
+}
+
+template<class T, class LockPool>
+atomic_linked_ptr<T, LockPool>& atomic_linked_ptr<T, LockPool>::operator=(value_type desired)
+{
+    store(std::move(desired));
+    return *this;
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef SMART_POINTERS_BIASED_LINKED_PTR_H
+#define SMART_POINTERS_BIASED_LINKED_PTR_H
+#include <atomic>
+#include <thread>
+#include "linked_ptr.h"
+#include "concurrent_linked_ptr.h"
+
+
+    // shared by all the owners of the object. The ring of owners is
+    // split in two: handles made on the thread that acquired the object
+    // join the local sub-ring with plain stores, handles made on any
+    // other thread join the shared sub-ring under the lock.
+    // rings counts the sub-rings that still have owners, the one
+    // that empties it last destroys the object
+struct biased_block
+{
+    std::thread::id owner;
+    list_node local;
+    list_node shared;
+    spinlock lock;
+    std::atomic<int> rings{ 1 };
+    void const* data{ nullptr };
+    deleter_storage deleter;
+};
+
+    // linked_ptr for objects mostly copied on the thread that created
+    // them: copies made there take no lock, copies made on other threads
+    // splice the shared sub-ring under a spinlock.
+    // care!! A handle in the local sub-ring must be moved and destroyed
+    // on the owner thread, share() gives a handle that can leave it
+template<class T>
+class biased_linked_ptr
+{
+private:
+    typedef void (biased_linked_ptr<T>::*bool_type)() const;
+    typedef biased_linked_ptr<T> this_type;
+    typedef std::lock_guard<spinlock> ring_guard;
+
+public:
+    biased_linked_ptr();
+
+    biased_linked_ptr(biased_linked_ptr<T> const& rhs);
+    biased_linked_ptr<T> const& operator=(biased_linked_ptr<T> const& rhs);
+
+    biased_linked_ptr(biased_linked_ptr<T>&& rhs) noexcept;
+    biased_linked_ptr<T> const& operator=(biased_linked_ptr<T>&& rhs) noexcept;
+
+    ~biased_linked_ptr();
+
+    template<class S> biased_linked_ptr(S* data);
+    template<class S> biased_linked_ptr(biased_linked_ptr<S> const& rhs);
+    template<class S> biased_linked_ptr<T> const& operator=(biased_linked_ptr<S> const& rhs);
+    template<class S, class D> biased_linked_ptr(S* data, D deleter);
+
+    void reset();
+    void reset(T* data);
+    template<class D>
+    void reset(T* data, D d);
+
+        // new owner in the shared sub-ring, whatever the thread
+    biased_linked_ptr<T> share() const;
+        // the handle is in the shared sub-ring
+    bool shared() const;
+
+    T* get();
+    T const* get() const;
+
+        // the other sub-ring is empty and this handle is alone in its own
+    bool unique() const;
+        // care!! Complexity is linear of the count. Only the owner
+        // thread can walk the local sub-ring: elsewhere the count is
+        // a lower bound, the shared owners alone
+    long use_count() const;
+
+    T& operator*();
+    T const& operator*() const;
+    T* operator->();
+    T const* operator->() const;
+
+    operator bool_type() const;
+
+    void swap(biased_linked_ptr<T>& rhs);
+
+private:
+    T* mData{ nullptr };
+    mutable list_node mNode;
+    biased_block* mBlock{ nullptr };
+    bool mShared{ false };
+
+    template<class S>
+    void join(biased_linked_ptr<S> const& rhs, bool shared);
+    template<class S>
+    void join_ring(biased_linked_ptr<S> const& rhs, list_node& anchor);
+    template<class S>
+    void take(biased_linked_ptr<S>& rhs);
+
+        // care!! The deleter releases the object when the block can't be made
+    static biased_block* acquire(void const* data, deleter_storage const& deleter);
+    static bool owner_thread(biased_block const* block);
+
+    void bool_test_function() const;
+
+    template<class S>
+    friend class biased_linked_ptr;
+};
+
+
+template<class T, class... Args>
+biased_linked_ptr<T> make_biased_linked(Args&&... args);
+
+
+template<class T>
+bool operator==(const biased_linked_ptr<T>& left, const biased_linked_ptr<T>& right);
+template<class T>
+bool operator!=(const biased_linked_ptr<T>& left, const biased_linked_ptr<T>& right);
+template<class T>
+bool operator<(const biased_linked_ptr<T>& left, const biased_linked_ptr<T>& right);
+
+#include "biased_linked_ptr.hpp"
+
+#endif
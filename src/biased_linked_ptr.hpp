@@ -0,0 +1,340 @@
+#ifndef SMART_POINTERS_BIASED_LINKED_PTR_CPP
+#define SMART_POINTERS_BIASED_LINKED_PTR_CPP
+
+#include <utility> // for move
+
+/*********************************************************/
+/*                   biased_linked_ptr                   */
+
+template<class T>
+biased_linked_ptr<T>::biased_linked_ptr()
+{
+}
+
+template<class T>
+biased_linked_ptr<T>::biased_linked_ptr(biased_linked_ptr<T> const& rhs)
+{
+    join(rhs, !owner_thread(rhs.mBlock));
+}
+
+template<class T>
+biased_linked_ptr<T> const& biased_linked_ptr<T>::operator=(biased_linked_ptr<T> const& rhs)
+{
+    if (mBlock != rhs.mBlock || mData != rhs.mData)
+    {
+        this_type(rhs).swap(*this);
+    }
+    return *this;
+}
+
+template<class T>
+biased_linked_ptr<T>::biased_linked_ptr(biased_linked_ptr<T>&& rhs) noexcept
+{
+    take(rhs);
+}
+
+template<class T>
+biased_linked_ptr<T> const& biased_linked_ptr<T>::operator=(biased_linked_ptr<T>&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        this_type ptr(std::move(rhs));
+        reset();
+        take(ptr);
+    }
+    return *this;
+}
+
+template<class T>
+biased_linked_ptr<T>::~biased_linked_ptr()
+{
+    reset();
+}
+
+template<class T>
+template<class S>
+biased_linked_ptr<T>::biased_linked_ptr(S* data)
+    : mData(data)
+    , mBlock(data != nullptr ? acquire(data, deleter_storage(data, data)) : nullptr)
+{
+    if (mBlock)
+        mNode.link(mBlock->local);
+}
+
+template<class T>
+template<class S>
+biased_linked_ptr<T>::biased_linked_ptr(biased_linked_ptr<S> const& rhs)
+{
+    join(rhs, !owner_thread(rhs.mBlock));
+}
+
+template<class T>
+template<class S>
+biased_linked_ptr<T> const& biased_linked_ptr<T>::operator=(biased_linked_ptr<S> const& rhs)
+{
+    if (mBlock != rhs.mBlock || mData != rhs.mData)
+    {
+        this_type(rhs).swap(*this);
+    }
+    return *this;
+}
+
+template<class T>
+template<class S, class D>
+biased_linked_ptr<T>::biased_linked_ptr(S* data, D deleter)
+    : mData(data)
+    , mBlock(acquire(data, deleter_storage(data, deleter, data)))
+{
+    mNode.link(mBlock->local);
+}
+
+template<class T>
+biased_block* biased_linked_ptr<T>::acquire(void const* data, deleter_storage const& deleter)
+{
+    biased_block* block = nullptr;
+    try
+    {
+        block = new biased_block;
+    }
+    catch (...)
+    {
+        deleter.destroy(data);
+        throw;
+    }
+    block->owner = std::this_thread::get_id();
+    block->data = data;
+    block->deleter = deleter;
+    return block;
+}
+
+template<class T>
+void biased_linked_ptr<T>::reset()
+{
+    if (mBlock)
+    {
+            // a sub-ring that empties gives up its share of the object.
+            // The lock is released first: the other sub-ring may be
+            // the last one and free the block right away
+        bool emptied;
+        if (mShared)
+        {
+            ring_guard guard(mBlock->lock);
+            mNode.unlink();
+            emptied = mBlock->shared.unique();
+        }
+        else
+        {
+            mNode.unlink();
+            emptied = mBlock->local.unique();
+        }
+        if (emptied && mBlock->rings.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            mBlock->deleter.destroy(mBlock->data);
+            delete mBlock;
+        }
+    }
+    mData = nullptr;
+    mBlock = nullptr;
+    mShared = false;
+}
+
+template<class T>
+void biased_linked_ptr<T>::reset(T* data)
+{
+    this_type(data).swap(*this);
+}
+
+template<class T>
+template<class D>
+void biased_linked_ptr<T>::reset(T* data, D d)
+{
+    this_type(data, d).swap(*this);
+}
+
+template<class T>
+biased_linked_ptr<T> biased_linked_ptr<T>::share() const
+{
+    this_type ptr;
+    ptr.join(*this, true);
+    return ptr;
+}
+
+template<class T>
+bool biased_linked_ptr<T>::shared() const
+{
+    return mShared;
+}
+
+template<class T>
+T* biased_linked_ptr<T>::get()
+{
+    return mData;
+}
+
+template<class T>
+T const* biased_linked_ptr<T>::get() const
+{
+    return mData;
+}
+
+template<class T>
+bool biased_linked_ptr<T>::unique() const
+{
+        // no other thread can add owners while this one is the last,
+        // a local handle is only used on the owner thread
+    if (!mBlock || mBlock->rings.load(std::memory_order_acquire) != 1)
+        return false;
+    if (!mShared)
+        return mNode.alone_with(mBlock->local);
+    ring_guard guard(mBlock->lock);
+    return mNode.alone_with(mBlock->shared);
+}
+
+template<class T>
+long biased_linked_ptr<T>::use_count() const
+{
+    if (!mBlock)
+        return 0;
+        // both anchors are members of their sub-rings
+    long count = 0;
+    if (owner_thread(mBlock))
+        count += mBlock->local.use_count() - 1;
+    ring_guard guard(mBlock->lock);
+    count += mBlock->shared.use_count() - 1;
+    return count;
+}
+
+template<class T>
+T& biased_linked_ptr<T>::operator*()
+{
+    return *mData;
+}
+
+template<class T>
+T const& biased_linked_ptr<T>::operator*() const
+{
+    return *mData;
+}
+
+template<class T>
+T* biased_linked_ptr<T>::operator->()
+{
+    return mData;
+}
+
+template<class T>
+T const* biased_linked_ptr<T>::operator->() const
+{
+    return mData;
+}
+
+template<class T>
+void biased_linked_ptr<T>::swap(biased_linked_ptr<T>& rhs)
+{
+        // the nodes may be in different sub-rings, each move
+        // takes the lock its own sub-ring needs
+    if (this != &rhs)
+    {
+        this_type ptr(std::move(rhs));
+        rhs.take(*this);
+        take(ptr);
+    }
+}
+
+template<class T>
+template<class S>
+void biased_linked_ptr<T>::join(biased_linked_ptr<S> const& rhs, bool shared)
+{
+    mData = rhs.mData;
+    mBlock = rhs.mBlock;
+    mShared = shared;
+    if (!mBlock)
+        return;
+    if (shared)
+    {
+        ring_guard guard(mBlock->lock);
+        join_ring(rhs, mBlock->shared);
+    }
+    else
+        join_ring(rhs, mBlock->local);
+}
+
+template<class T>
+template<class S>
+void biased_linked_ptr<T>::join_ring(biased_linked_ptr<S> const& rhs, list_node& anchor)
+{
+    if (rhs.mShared == mShared)
+    {
+        mNode.link(rhs.mNode);
+        return;
+    }
+        // rhs keeps the object alive, an empty sub-ring
+        // can safely take its share back
+    if (anchor.unique())
+        mBlock->rings.fetch_add(1, std::memory_order_relaxed);
+    mNode.link(anchor);
+}
+
+template<class T>
+template<class S>
+void biased_linked_ptr<T>::take(biased_linked_ptr<S>& rhs)
+{
+    if (rhs.mShared)
+    {
+        ring_guard guard(rhs.mBlock->lock);
+        mNode.take(rhs.mNode);
+    }
+    else
+        mNode.take(rhs.mNode);
+    mData = rhs.mData;
+    mBlock = rhs.mBlock;
+    mShared = rhs.mShared;
+    rhs.mData = nullptr;
+    rhs.mBlock = nullptr;
+    rhs.mShared = false;
+}
+
+template<class T>
+bool biased_linked_ptr<T>::owner_thread(biased_block const* block)
+{
+    return block != nullptr && block->owner == std::this_thread::get_id();
+}
+
+template<class T>
+void biased_linked_ptr<T>::bool_test_function() const
+{
+}
+
+template<class T>
+biased_linked_ptr<T>::operator bool_type() const
+{
+    return mData != nullptr ? &biased_linked_ptr<T>::bool_test_function : nullptr;
+}
+
+
+template<class T, class... Args>
+biased_linked_ptr<T> make_biased_linked(Args&&... args)
+{
+    return biased_linked_ptr<T>(new T(std::forward<Args>(args)...));
+}
+
+
+template<class T>
+bool operator==(biased_linked_ptr<T> const& left, biased_linked_ptr<T> const& right)
+{
+    return left.get() == right.get();
+}
+
+template<class T>
+bool operator!=(biased_linked_ptr<T> const& left, biased_linked_ptr<T> const& right)
+{
+    return !(left == right);
+}
+
+template<class T>
+bool operator<(biased_linked_ptr<T> const& left, biased_linked_ptr<T> const& right)
+{
+    return left.get() < right.get();
+}
+
+#endif
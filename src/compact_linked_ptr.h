@@ -0,0 +1,27 @@
+#ifndef SMART_POINTERS_COMPACT_LINKED_PTR_H
+#define SMART_POINTERS_COMPACT_LINKED_PTR_H
+#include "counted_linked_ptr.h"
+
+
+    // linked_ptr squeezed into two words, half of linked_ptr: the
+    // object pointer and a header shared by the owners that keeps
+    // their count and the deleter. That's the layout of
+    // counted_linked_ptr, the name says what it's picked for.
+    // Copying, moving and destroying are constant time: a handle
+    // has no neighbours to fix, a vector of them relocates as plain
+    // words. Custom deleters are supported, make_compact_linked puts
+    // the object in the header's allocation.
+    // care!! Not thread-safe, as counted_linked_ptr
+template<class T>
+using compact_linked_ptr = counted_linked_ptr<T>;
+
+static_assert(sizeof(compact_linked_ptr<int>) == 2 * sizeof(void*),
+    "compact_linked_ptr must stay two words");
+
+
+template<class T, class... Args>
+compact_linked_ptr<T> make_compact_linked(Args&&... args);
+
+#include "compact_linked_ptr.hpp"
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef SMART_POINTERS_COMPACT_LINKED_PTR_CPP
+#define SMART_POINTERS_COMPACT_LINKED_PTR_CPP
+
+#include <utility> // for forward
+
+template<class T, class... Args>
+compact_linked_ptr<T> make_compact_linked(Args&&... args)
+{
+    return make_counted_linked<T>(std::forward<Args>(args)...);
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef SMART_POINTERS_CONCURRENT_LINKED_PTR_H
+#define SMART_POINTERS_CONCURRENT_LINKED_PTR_H
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include "linked_ptr.h"
+
+
+    // fixed pool of mutexes, the object's address selects the one
+    // that guards its ring
+template<std::size_t N = 64>
+class mutex_pool
+{
+public:
+    typedef std::mutex lock_type;
+
+    static lock_type& get(void const* key);
+
+private:
+    struct alignas(64) padded_lock
+    {
+        lock_type lock;
+    };
+    static padded_lock sLocks[N];
+};
+
+    // test-and-test-and-set lock, yields the thread when it spins too long.
+    // A ring splice holds the lock for a few stores only
+class spinlock
+{
+public:
+    void lock() noexcept;
+    bool try_lock() noexcept;
+    void unlock() noexcept;
+
+private:
+    std::atomic<bool> mLocked{ false };
+};
+
+    // same as mutex_pool, but with spinlocks: cheaper to take
+    // when the ring is only briefly contended
+template<std::size_t N = 64>
+class spinlock_pool
+{
+public:
+    typedef spinlock lock_type;
+
+    static lock_type& get(void const* key);
+
+private:
+    struct alignas(64) padded_lock
+    {
+        lock_type lock;
+    };
+    static padded_lock sLocks[N];
+};
+
+    // linked_ptr whose handles may be copied and destroyed from different
+    // threads: every splice of the ring is done under the pool lock
+    // selected by the owned object. The last owner runs the deleter
+    // after the lock is released
+template<class T, class LockPool = mutex_pool<>>
+class concurrent_linked_ptr
+{
+private:
+    typedef void (concurrent_linked_ptr<T, LockPool>::*bool_type)() const;
+    typedef concurrent_linked_ptr<T, LockPool> this_type;
+    typedef std::unique_lock<typename LockPool::lock_type> ring_guard;
+        // std::mutex may throw when it's locked,
+        // moves are noexcept only for locks that can't
+    static bool const NOTHROW_LOCK = noexcept(std::declval<typename LockPool::lock_type&>().lock());
+
+public:
+    concurrent_linked_ptr();
+
+    concurrent_linked_ptr(concurrent_linked_ptr<T, LockPool> const& rhs);
+    concurrent_linked_ptr<T, LockPool> const& operator=(concurrent_linked_ptr<T, LockPool> const& rhs);
+
+    concurrent_linked_ptr(concurrent_linked_ptr<T, LockPool>&& rhs) noexcept(NOTHROW_LOCK);
+    concurrent_linked_ptr<T, LockPool> const& operator=(concurrent_linked_ptr<T, LockPool>&& rhs) noexcept(NOTHROW_LOCK);
+
+    ~concurrent_linked_ptr();
+
+    template<class S> concurrent_linked_ptr(S* data);
+    template<class S> concurrent_linked_ptr(concurrent_linked_ptr<S, LockPool> const& rhs);
+    template<class S, class D> concurrent_linked_ptr(S* data, D deleter);
+        // takes the object from a pointer that doesn't share it yet
+    explicit concurrent_linked_ptr(linked_ptr<T>&& rhs);
+
+    void reset();
+
+    T* get();
+    T const* get() const;
+
+    bool unique() const;
+    long use_count() const;
+
+    T& operator*();
+    T const& operator*() const;
+    T* operator->();
+    T const* operator->() const;
+
+    operator bool_type() const;
+
+    void swap(concurrent_linked_ptr<T, LockPool>& rhs);
+
+private:
+    linked_ptr<T> mPtr;
+
+    template<class S>
+    concurrent_linked_ptr(linked_ptr<S> const& rhs, ring_guard const& guard);
+    template<class S>
+    concurrent_linked_ptr(linked_ptr<S>&& rhs, ring_guard const& guard);
+
+    template<class S>
+    static ring_guard lock_ring(linked_ptr<S> const& ptr);
+
+    void bool_test_function() const;
+
+    template<class S, class P>
+    friend class concurrent_linked_ptr;
+};
+
+
+template<class T, class LockPool = mutex_pool<>, class... Args>
+concurrent_linked_ptr<T, LockPool> make_concurrent_linked(Args&&... args);
+
+
+template<class T, class P>
+bool operator==(const concurrent_linked_ptr<T, P>& left, const concurrent_linked_ptr<T, P>& right);
+template<class T, class P>
+bool operator!=(const concurrent_linked_ptr<T, P>& left, const concurrent_linked_ptr<T, P>& right);
+template<class T, class P>
+bool operator<(const concurrent_linked_ptr<T, P>& left, const concurrent_linked_ptr<T, P>& right);
+
+#include "concurrent_linked_ptr.hpp"
+
+#endif
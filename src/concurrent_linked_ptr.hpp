@@ -0,0 +1,285 @@
+#ifndef SMART_POINTERS_CONCURRENT_LINKED_PTR_CPP
+#define SMART_POINTERS_CONCURRENT_LINKED_PTR_CPP
+
+#include <cstdint>
+#include <functional> // for less
+#include <thread> // for yield
+#include <utility> // for swap
+
+/*********************************************************/
+/*                      lock pools                       */
+
+    // objects are at least 8-aligned and often allocated close
+    // to each other, mix the higher bits in before picking the slot
+inline std::size_t lock_pool_index(void const* key, std::size_t size)
+{
+    std::uintptr_t hash = reinterpret_cast<std::uintptr_t>(key);
+    hash ^= hash >> 12;
+    return static_cast<std::size_t>((hash >> 4) % size);
+}
+
+template<std::size_t N>
+typename mutex_pool<N>::padded_lock mutex_pool<N>::sLocks[N];
+
+template<std::size_t N>
+typename mutex_pool<N>::lock_type& mutex_pool<N>::get(void const* key)
+{
+    return sLocks[lock_pool_index(key, N)].lock;
+}
+
+inline void spinlock::lock() noexcept
+{
+    int spins = 0;
+    while (mLocked.exchange(true, std::memory_order_acquire))
+    {
+        while (mLocked.load(std::memory_order_relaxed))
+        {
+            if (++spins > 64)
+            {
+                std::this_thread::yield();
+                spins = 0;
+            }
+        }
+    }
+}
+
+inline bool spinlock::try_lock() noexcept
+{
+    return !mLocked.load(std::memory_order_relaxed)
+        && !mLocked.exchange(true, std::memory_order_acquire);
+}
+
+inline void spinlock::unlock() noexcept
+{
+    mLocked.store(false, std::memory_order_release);
+}
+
+template<std::size_t N>
+typename spinlock_pool<N>::padded_lock spinlock_pool<N>::sLocks[N];
+
+template<std::size_t N>
+typename spinlock_pool<N>::lock_type& spinlock_pool<N>::get(void const* key)
+{
+    return sLocks[lock_pool_index(key, N)].lock;
+}
+
+/*********************************************************/
+/*                concurrent_linked_ptr                  */
+
+template<class T, class LockPool>
+concurrent_linked_ptr<T, LockPool>::concurrent_linked_ptr()
+{
+}
+
+template<class T, class LockPool>
+concurrent_linked_ptr<T, LockPool>::concurrent_linked_ptr(concurrent_linked_ptr<T, LockPool> const& rhs)
+    : concurrent_linked_ptr(rhs.mPtr, lock_ring(rhs.mPtr))
+{
+}
+
+template<class T, class LockPool>
+concurrent_linked_ptr<T, LockPool> const& concurrent_linked_ptr<T, LockPool>::operator=(concurrent_linked_ptr<T, LockPool> const& rhs)
+{
+        // rhs is copied under its own lock before the old value goes,
+        // it may be reachable only through the released object
+    if (this != &rhs)
+    {
+        this_type(rhs).swap(*this);
+    }
+    return *this;
+}
+
+template<class T, class LockPool>
+concurrent_linked_ptr<T, LockPool>::concurrent_linked_ptr(concurrent_linked_ptr<T, LockPool>&& rhs) noexcept(NOTHROW_LOCK)
+    : concurrent_linked_ptr(std::move(rhs.mPtr), lock_ring(rhs.mPtr))
+{
+}
+
+template<class T, class LockPool>
+concurrent_linked_ptr<T, LockPool> const& concurrent_linked_ptr<T, LockPool>::operator=(concurrent_linked_ptr<T, LockPool>&& rhs) noexcept(NOTHROW_LOCK)
+{
+    if (this != &rhs)
+    {
+        this_type(std::move(rhs)).swap(*this);
+    }
+    return *this;
+}
+
+template<class T, class LockPool>
+concurrent_linked_ptr<T, LockPool>::~concurrent_linked_ptr()
+{
+    reset();
+}
+
+template<class T, class LockPool>
+template<class S>
+concurrent_linked_ptr<T, LockPool>::concurrent_linked_ptr(S* data)
+    : mPtr(data)
+{
+}
+
+template<class T, class LockPool>
+template<class S>
+concurrent_linked_ptr<T, LockPool>::concurrent_linked_ptr(concurrent_linked_ptr<S, LockPool> const& rhs)
+    : concurrent_linked_ptr(rhs.mPtr, lock_ring(rhs.mPtr))
+{
+}
+
+template<class T, class LockPool>
+template<class S, class D>
+concurrent_linked_ptr<T, LockPool>::concurrent_linked_ptr(S* data, D deleter)
+    : mPtr(data, deleter)
+{
+}
+
+template<class T, class LockPool>
+concurrent_linked_ptr<T, LockPool>::concurrent_linked_ptr(linked_ptr<T>&& rhs)
+    : mPtr(std::move(rhs))
+{
+}
+
+template<class T, class LockPool>
+template<class S>
+concurrent_linked_ptr<T, LockPool>::concurrent_linked_ptr(linked_ptr<S> const& rhs, ring_guard const& guard)
+    : mPtr(guard.owns_lock() ? linked_ptr<T>(rhs) : linked_ptr<T>())
+{
+}
+
+template<class T, class LockPool>
+template<class S>
+concurrent_linked_ptr<T, LockPool>::concurrent_linked_ptr(linked_ptr<S>&& rhs, ring_guard const&)
+    : mPtr(std::move(rhs))
+{
+}
+
+template<class T, class LockPool>
+template<class S>
+typename concurrent_linked_ptr<T, LockPool>::ring_guard concurrent_linked_ptr<T, LockPool>::lock_ring(linked_ptr<S> const& ptr)
+{
+    void const* key = ptr.owned();
+    if (key == nullptr)
+        return ring_guard();
+    return ring_guard(LockPool::get(key));
+}
+
+template<class T, class LockPool>
+void concurrent_linked_ptr<T, LockPool>::reset()
+{
+        // the last owner leaves the ring under the lock,
+        // but the object is destroyed after it's released
+    linked_ptr<T> last;
+    {
+        ring_guard guard(lock_ring(mPtr));
+        if (mPtr.unique())
+            last = std::move(mPtr);
+        else
+            mPtr.reset();
+    }
+}
+
+template<class T, class LockPool>
+T* concurrent_linked_ptr<T, LockPool>::get()
+{
+    return mPtr.get();
+}
+
+template<class T, class LockPool>
+T const* concurrent_linked_ptr<T, LockPool>::get() const
+{
+    return mPtr.get();
+}
+
+template<class T, class LockPool>
+bool concurrent_linked_ptr<T, LockPool>::unique() const
+{
+    ring_guard guard(lock_ring(mPtr));
+    return mPtr.unique();
+}
+
+template<class T, class LockPool>
+long concurrent_linked_ptr<T, LockPool>::use_count() const
+{
+    ring_guard guard(lock_ring(mPtr));
+    return mPtr.use_count();
+}
+
+template<class T, class LockPool>
+T& concurrent_linked_ptr<T, LockPool>::operator*()
+{
+    return *mPtr;
+}
+
+template<class T, class LockPool>
+T const& concurrent_linked_ptr<T, LockPool>::operator*() const
+{
+    return *mPtr;
+}
+
+template<class T, class LockPool>
+T* concurrent_linked_ptr<T, LockPool>::operator->()
+{
+    return mPtr.get();
+}
+
+template<class T, class LockPool>
+T const* concurrent_linked_ptr<T, LockPool>::operator->() const
+{
+    return mPtr.get();
+}
+
+template<class T, class LockPool>
+void concurrent_linked_ptr<T, LockPool>::swap(concurrent_linked_ptr<T, LockPool>& rhs)
+{
+    if (this == &rhs)
+        return;
+        // both rings are locked, always in the same order
+    typedef typename LockPool::lock_type lock_type;
+    lock_type* first = mPtr.owned() ? &LockPool::get(mPtr.owned()) : nullptr;
+    lock_type* second = rhs.mPtr.owned() ? &LockPool::get(rhs.mPtr.owned()) : nullptr;
+    if (first == second)
+        second = nullptr;
+    if (first == nullptr || (second != nullptr && std::less<lock_type*>()(second, first)))
+        std::swap(first, second);
+    ring_guard firstGuard = first ? ring_guard(*first) : ring_guard();
+    ring_guard secondGuard = second ? ring_guard(*second) : ring_guard();
+    mPtr.swap(rhs.mPtr);
+}
+
+template<class T, class LockPool>
+void concurrent_linked_ptr<T, LockPool>::bool_test_function() const
+{
+}
+
+template<class T, class LockPool>
+concurrent_linked_ptr<T, LockPool>::operator bool_type() const
+{
+    return mPtr.get() != nullptr ? &concurrent_linked_ptr<T, LockPool>::bool_test_function : nullptr;
+}
+
+
+template<class T, class LockPool, class... Args>
+concurrent_linked_ptr<T, LockPool> make_concurrent_linked(Args&&... args)
+{
+    return concurrent_linked_ptr<T, LockPool>(make_linked<T>(std::forward<Args>(args)...));
+}
+
+
+template<class T, class P>
+bool operator==(concurrent_linked_ptr<T, P> const& left, concurrent_linked_ptr<T, P> const& right)
+{
+    return left.get() == right.get();
+}
+
+template<class T, class P>
+bool operator!=(concurrent_linked_ptr<T, P> const& left, concurrent_linked_ptr<T, P> const& right)
+{
+    return !(left == right);
+}
+
+template<class T, class P>
+bool operator<(concurrent_linked_ptr<T, P> const& left, concurrent_linked_ptr<T, P> const& right)
+{
+    return left.get() < right.get();
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef SMART_POINTERS_COUNTED_LINKED_PTR_H
+#define SMART_POINTERS_COUNTED_LINKED_PTR_H
+#include "linked_ptr.h"
+
+
+    // shared by every owner, keeps the count of owners
+    // so that use_count() doesn't have to walk a list
+struct counted_header
+{
+    virtual ~counted_header() {}
+        // destroys the object, then frees the header
+    virtual void release();
+
+    long count{ 1 };
+    void const* data{ nullptr };
+    deleter_storage deleter;
+};
+
+    // owners share a header with their count instead of linking
+    // into a ring: use_count() and unique() are constant time, where
+    // linked_ptr walks its ring. The header is allocated once when the
+    // object is acquired, make_counted_linked puts the object in the
+    // same allocation; copying and destroying stay allocation-free.
+    // Unlike std::shared_ptr the count is a plain long and there is
+    // no weak count: nothing is atomic, a copy is one increment.
+    // care!! Not thread-safe, owners of one object must stay on one
+    // thread or be copied and released under a common lock
+template<class T>
+class counted_linked_ptr
+{
+private:
+    typedef void (counted_linked_ptr<T>::*bool_type)() const;
+    typedef counted_linked_ptr<T> this_type;
+
+public:
+    counted_linked_ptr();
+
+    counted_linked_ptr(counted_linked_ptr<T> const& rhs);
+    counted_linked_ptr<T> const& operator=(counted_linked_ptr<T> const& rhs);
+
+    counted_linked_ptr(counted_linked_ptr<T>&& rhs) noexcept;
+    counted_linked_ptr<T> const& operator=(counted_linked_ptr<T>&& rhs) noexcept;
+
+    ~counted_linked_ptr();
+
+    template<class S> counted_linked_ptr(S* data);
+    template<class S> counted_linked_ptr(counted_linked_ptr<S> const& rhs);
+    template<class S> counted_linked_ptr<T> const& operator=(counted_linked_ptr<S> const& rhs);
+    template<class S, class D> counted_linked_ptr(S* data, D deleter);
+
+    void reset();
+    void reset(T* data);
+    template<class D>
+    void reset(T* data, D d);
+
+    T* get();
+    T const* get() const;
+
+    bool unique() const;
+    long use_count() const;
+
+    T& operator*();
+    T const& operator*() const;
+    T* operator->();
+    T const* operator->() const;
+
+    operator bool_type() const;
+
+    void swap(counted_linked_ptr<T>& rhs);
+
+private:
+    T* mData{ nullptr };
+    counted_header* mHeader{ nullptr };
+
+        // care!! The deleter releases the object when the header can't be made
+    static counted_header* acquire(void const* data, deleter_storage const& deleter);
+
+    void bool_test_function() const;
+
+    template<class S, class... Args>
+    friend counted_linked_ptr<S> make_counted_linked(Args&&... args);
+
+    template<class S>
+    friend class counted_linked_ptr;
+};
+
+
+template<class T, class... Args>
+counted_linked_ptr<T> make_counted_linked(Args&&... args);
+
+
+template<class T>
+bool operator==(const counted_linked_ptr<T>& left, const counted_linked_ptr<T>& right);
+template<class T>
+bool operator!=(const counted_linked_ptr<T>& left, const counted_linked_ptr<T>& right);
+template<class T>
+bool operator<(const counted_linked_ptr<T>& left, const counted_linked_ptr<T>& right);
+
+#include "counted_linked_ptr.hpp"
+
+#endif
@@ -0,0 +1,271 @@
+#ifndef SMART_POINTERS_COUNTED_LINKED_PTR_CPP
+#define SMART_POINTERS_COUNTED_LINKED_PTR_CPP
+
+#include <utility> // for swap
+
+/*********************************************************/
+/*                   counted header                      */
+
+inline void counted_header::release()
+{
+    deleter.destroy(data);
+    delete this;
+}
+
+    // header of make_counted_linked, the object is constructed
+    // right after it in the same allocation
+template<class T>
+struct counted_block : public counted_header
+{
+    template<class... Args>
+    counted_block(Args&&... args)
+    {
+        new (&mStorage) T(std::forward<Args>(args)...);
+    }
+
+    T* get() const
+    {
+        return reinterpret_cast<T*>(&mStorage);
+    }
+
+    void release()
+    {
+        get()->~T();
+        delete this;
+    }
+
+private:
+    mutable typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type mStorage;
+};
+
+/*********************************************************/
+/*                 counted_linked_ptr                    */
+
+template<class T>
+counted_linked_ptr<T>::counted_linked_ptr()
+{
+}
+
+template<class T>
+counted_linked_ptr<T>::counted_linked_ptr(counted_linked_ptr<T> const& rhs)
+    : mData(rhs.mData)
+    , mHeader(rhs.mHeader)
+{
+    if (mHeader)
+        ++mHeader->count;
+}
+
+template<class T>
+counted_linked_ptr<T> const& counted_linked_ptr<T>::operator=(counted_linked_ptr<T> const& rhs)
+{
+    if (mHeader != rhs.mHeader)
+    {
+        this_type(rhs).swap(*this);
+    }
+    return *this;
+}
+
+template<class T>
+counted_linked_ptr<T>::counted_linked_ptr(counted_linked_ptr<T>&& rhs) noexcept
+    : mData(rhs.mData)
+    , mHeader(rhs.mHeader)
+{
+    rhs.mData = nullptr;
+    rhs.mHeader = nullptr;
+}
+
+template<class T>
+counted_linked_ptr<T> const& counted_linked_ptr<T>::operator=(counted_linked_ptr<T>&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        this_type(std::move(rhs)).swap(*this);
+    }
+    return *this;
+}
+
+template<class T>
+counted_linked_ptr<T>::~counted_linked_ptr()
+{
+    reset();
+}
+
+template<class T>
+template<class S>
+counted_linked_ptr<T>::counted_linked_ptr(S* data)
+    : mData(data)
+    , mHeader(data != nullptr ? acquire(data, deleter_storage(data, data)) : nullptr)
+{
+}
+
+template<class T>
+template<class S>
+counted_linked_ptr<T>::counted_linked_ptr(counted_linked_ptr<S> const& rhs)
+    : mData(rhs.mData)
+    , mHeader(rhs.mHeader)
+{
+    if (mHeader)
+        ++mHeader->count;
+}
+
+template<class T>
+template<class S>
+counted_linked_ptr<T> const& counted_linked_ptr<T>::operator=(counted_linked_ptr<S> const& rhs)
+{
+    if (mHeader != rhs.mHeader)
+    {
+        this_type(rhs).swap(*this);
+    }
+    return *this;
+}
+
+template<class T>
+template<class S, class D>
+counted_linked_ptr<T>::counted_linked_ptr(S* data, D deleter)
+    : mData(data)
+    , mHeader(acquire(data, deleter_storage(data, deleter, data)))
+{
+}
+
+template<class T>
+counted_header* counted_linked_ptr<T>::acquire(void const* data, deleter_storage const& deleter)
+{
+    counted_header* header = nullptr;
+    try
+    {
+        header = new counted_header;
+    }
+    catch (...)
+    {
+        deleter.destroy(data);
+        throw;
+    }
+    header->data = data;
+    header->deleter = deleter;
+    return header;
+}
+
+template<class T>
+void counted_linked_ptr<T>::reset()
+{
+    if (mHeader && --mHeader->count == 0)
+        mHeader->release();
+    mData = nullptr;
+    mHeader = nullptr;
+}
+
+template<class T>
+void counted_linked_ptr<T>::reset(T* data)
+{
+    this_type(data).swap(*this);
+}
+
+template<class T>
+template<class D>
+void counted_linked_ptr<T>::reset(T* data, D d)
+{
+    this_type(data, d).swap(*this);
+}
+
+template<class T>
+T* counted_linked_ptr<T>::get()
+{
+    return mData;
+}
+
+template<class T>
+T const* counted_linked_ptr<T>::get() const
+{
+    return mData;
+}
+
+template<class T>
+bool counted_linked_ptr<T>::unique() const
+{
+    return use_count() == 1;
+}
+
+template<class T>
+long counted_linked_ptr<T>::use_count() const
+{
+    if (!mHeader)
+        return 0;
+    return mHeader->count;
+}
+
+template<class T>
+T& counted_linked_ptr<T>::operator*()
+{
+    return *mData;
+}
+
+template<class T>
+T const& counted_linked_ptr<T>::operator*() const
+{
+    return *mData;
+}
+
+template<class T>
+T* counted_linked_ptr<T>::operator->()
+{
+    return mData;
+}
+
+template<class T>
+T const* counted_linked_ptr<T>::operator->() const
+{
+    return mData;
+}
+
+template<class T>
+void counted_linked_ptr<T>::swap(counted_linked_ptr<T>& rhs)
+{
+    if (mHeader != rhs.mHeader)
+    {
+        std::swap(mData, rhs.mData);
+        std::swap(mHeader, rhs.mHeader);
+    }
+}
+
+template<class T>
+void counted_linked_ptr<T>::bool_test_function() const
+{
+}
+
+template<class T>
+counted_linked_ptr<T>::operator bool_type() const
+{
+    return mData != nullptr ? &counted_linked_ptr<T>::bool_test_function : nullptr;
+}
+
+
+template<class T, class... Args>
+counted_linked_ptr<T> make_counted_linked(Args&&... args)
+{
+    counted_block<T>* block = new counted_block<T>(std::forward<Args>(args)...);
+    counted_linked_ptr<T> ptr;
+    ptr.mData = block->get();
+    ptr.mHeader = block;
+    return ptr;
+}
+
+
+template<class T>
+bool operator==(counted_linked_ptr<T> const& left, counted_linked_ptr<T> const& right)
+{
+    return left.get() == right.get();
+}
+
+template<class T>
+bool operator!=(counted_linked_ptr<T> const& left, counted_linked_ptr<T> const& right)
+{
+    return !(left == right);
+}
+
+template<class T>
+bool operator<(counted_linked_ptr<T> const& left, counted_linked_ptr<T> const& right)
+{
+    return left.get() < right.get();
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef SMART_POINTERS_EPOCH_PUBLISHER_H
+#define SMART_POINTERS_EPOCH_PUBLISHER_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "linked_ptr.h"
+
+
+    // readers announce the epoch they entered in, replaced objects are
+    // retired with the epoch they were replaced in and released once
+    // every reader inside has entered in a later epoch
+class epoch_domain
+{
+public:
+    static std::size_t const SLOTS = 128;
+
+    epoch_domain();
+        // releases everything retired, no reader may be inside anymore
+    ~epoch_domain();
+
+    epoch_domain(epoch_domain const&) = delete;
+    epoch_domain& operator=(epoch_domain const&) = delete;
+
+        // keeps the owner alive until the readers move past this moment
+    template<class T>
+    void retire(linked_ptr<T>&& owner);
+        // releases what no reader can see anymore, returns how many
+    std::size_t reclaim();
+        // objects retired but not released yet
+    std::size_t retired() const;
+
+private:
+    struct retired_base
+    {
+        virtual ~retired_base() {}
+        std::uint64_t epoch{ 0 };
+    };
+    template<class T>
+    struct retired_owner;
+
+    struct alignas(64) reader_slot
+    {
+            // epoch the reader entered in, 0 when the slot is free
+        std::atomic<std::uint64_t> epoch{ 0 };
+    };
+
+    std::atomic<std::uint64_t> mEpoch{ 1 };
+    reader_slot mSlots[SLOTS];
+    mutable std::mutex mMutex;
+    std::vector<std::unique_ptr<retired_base>> mRetired;
+
+    std::size_t enter();
+    void leave(std::size_t slot);
+    std::uint64_t oldest_reader() const;
+
+    friend class epoch_guard;
+};
+
+    // marks the current thread as a reader of the domain for its
+    // lifetime, pointers read under the guard stay valid until it ends
+class epoch_guard
+{
+public:
+    explicit epoch_guard(epoch_domain& domain);
+    ~epoch_guard();
+
+    epoch_guard(epoch_guard const&) = delete;
+    epoch_guard& operator=(epoch_guard const&) = delete;
+
+private:
+    epoch_domain& mDomain;
+    std::size_t mSlot;
+};
+
+    // holds the current object, readers get to it under an epoch_guard
+    // without joining its ring. The replaced owner is retired
+    // into the domain, so the last owner's delete waits for the readers.
+    // The rings are only ever touched by the writer: publish() and the
+    // domain's reclaim() are meant to be called from one thread
+template<class T>
+class epoch_publisher
+{
+public:
+    explicit epoch_publisher(epoch_domain& domain);
+    epoch_publisher(epoch_domain& domain, linked_ptr<T> const& initial);
+    ~epoch_publisher();
+
+    epoch_publisher(epoch_publisher<T> const&) = delete;
+    epoch_publisher<T>& operator=(epoch_publisher<T> const&) = delete;
+
+    void publish(linked_ptr<T> const& next);
+
+        // valid as long as the guard lives
+    T* read(epoch_guard const& guard) const;
+
+private:
+    epoch_domain& mDomain;
+    std::atomic<T*> mCurrent{ nullptr };
+    linked_ptr<T> mOwner;
+};
+
+#include "epoch_publisher.hpp"
+
+#endif
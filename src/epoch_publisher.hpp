@@ -0,0 +1,158 @@
+#ifndef SMART_POINTERS_EPOCH_PUBLISHER_CPP
+#define SMART_POINTERS_EPOCH_PUBLISHER_CPP
+
+#include <functional> // for hash
+#include <thread> // for yield and id
+#include <utility> // for move
+
+/*********************************************************/
+/*                     epoch_domain                      */
+
+template<class T>
+struct epoch_domain::retired_owner : public epoch_domain::retired_base
+{
+    explicit retired_owner(linked_ptr<T>&& rhs)
+        : owner(std::move(rhs))
+    {
+    }
+    linked_ptr<T> owner;
+};
+
+inline epoch_domain::epoch_domain()
+{
+}
+
+inline epoch_domain::~epoch_domain()
+{
+}
+
+template<class T>
+void epoch_domain::retire(linked_ptr<T>&& owner)
+{
+    std::unique_ptr<retired_base> item(new retired_owner<T>(std::move(owner)));
+        // readers entering from now on can't see the retired object
+    item->epoch = mEpoch.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mRetired.push_back(std::move(item));
+    }
+    reclaim();
+}
+
+inline std::size_t epoch_domain::reclaim()
+{
+    std::vector<std::unique_ptr<retired_base>> released;
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        std::uint64_t const oldest = oldest_reader();
+        std::size_t kept{ 0 };
+        for (std::unique_ptr<retired_base>& item : mRetired)
+        {
+            if (item->epoch < oldest)
+                released.push_back(std::move(item));
+            else
+                mRetired[kept++] = std::move(item);
+        }
+        mRetired.resize(kept);
+    }
+        // owners are dropped without the lock, destructors may retire more
+    return released.size();
+}
+
+inline std::size_t epoch_domain::retired() const
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mRetired.size();
+}
+
+inline std::size_t epoch_domain::enter()
+{
+    std::size_t slot = std::hash<std::thread::id>()(std::this_thread::get_id()) % SLOTS;
+    while (true)
+    {
+        for (std::size_t i = 0; i < SLOTS; ++i, slot = (slot + 1) % SLOTS)
+        {
+            std::uint64_t free{ 0 };
+            if (mSlots[slot].epoch.load(std::memory_order_relaxed) == 0
+                && mSlots[slot].epoch.compare_exchange_strong(free, mEpoch.load()))
+            {
+                    // the epoch may have moved on before the slot got it,
+                    // then the reader is only more careful than needed
+                return slot;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+inline void epoch_domain::leave(std::size_t slot)
+{
+    mSlots[slot].epoch.store(0, std::memory_order_release);
+}
+
+inline std::uint64_t epoch_domain::oldest_reader() const
+{
+    std::uint64_t oldest{ mEpoch.load() };
+    for (reader_slot const& slot : mSlots)
+    {
+        std::uint64_t const epoch{ slot.epoch.load() };
+        if (epoch != 0 && epoch < oldest)
+            oldest = epoch;
+    }
+    return oldest;
+}
+
+/*********************************************************/
+/*                      epoch_guard                      */
+
+inline epoch_guard::epoch_guard(epoch_domain& domain)
+    : mDomain(domain)
+    , mSlot(domain.enter())
+{
+}
+
+inline epoch_guard::~epoch_guard()
+{
+    mDomain.leave(mSlot);
+}
+
+/*********************************************************/
+/*                    epoch_publisher                    */
+
+template<class T>
+epoch_publisher<T>::epoch_publisher(epoch_domain& domain)
+    : mDomain(domain)
+{
+}
+
+template<class T>
+epoch_publisher<T>::epoch_publisher(epoch_domain& domain, linked_ptr<T> const& initial)
+    : mDomain(domain)
+    , mCurrent(const_cast<T*>(initial.get()))
+    , mOwner(initial)
+{
+}
+
+template<class T>
+epoch_publisher<T>::~epoch_publisher()
+{
+    mCurrent.store(nullptr);
+    mDomain.retire(std::move(mOwner));
+}
+
+template<class T>
+void epoch_publisher<T>::publish(linked_ptr<T> const& next)
+{
+    linked_ptr<T> replaced(next);
+    mOwner.swap(replaced);
+    mCurrent.store(mOwner.get());
+    mDomain.retire(std::move(replaced));
+}
+
+template<class T>
+T* epoch_publisher<T>::read(epoch_guard const&) const
+{
+    return mCurrent.load();
+}
+
+#endif
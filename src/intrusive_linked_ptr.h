@@ -0,0 +1,98 @@
+#ifndef SMART_POINTERS_INTRUSIVE_LINKED_PTR_H
+#define SMART_POINTERS_INTRUSIVE_LINKED_PTR_H
+#include "linked_ptr.h"
+
+
+    // base of the objects owned by intrusive_linked_ptr: carries the
+    // anchor of the ring of owners, which always stays at its tail.
+    // Copies of the object start with a ring of their own
+class linked_hook
+{
+public:
+    linked_hook();
+    linked_hook(linked_hook const& rhs);
+    linked_hook& operator=(linked_hook const& rhs);
+
+protected:
+    ~linked_hook();
+
+private:
+    mutable list_node mAnchor;
+
+    template<class T>
+    friend class intrusive_linked_ptr;
+};
+
+    // linked_ptr for objects derived from linked_hook: the object is
+    // the anchor of its own ring, so handles carry no deleter and
+    // the last owner is found without walking the ring.
+    // The object is destroyed with delete
+template<class T>
+class intrusive_linked_ptr
+{
+private:
+    typedef void (intrusive_linked_ptr<T>::*bool_type)() const;
+    typedef intrusive_linked_ptr<T> this_type;
+
+public:
+    intrusive_linked_ptr();
+
+    intrusive_linked_ptr(intrusive_linked_ptr<T> const& rhs);
+    intrusive_linked_ptr<T> const& operator=(intrusive_linked_ptr<T> const& rhs);
+
+    intrusive_linked_ptr(intrusive_linked_ptr<T>&& rhs) noexcept;
+    intrusive_linked_ptr<T> const& operator=(intrusive_linked_ptr<T>&& rhs) noexcept;
+
+    ~intrusive_linked_ptr();
+
+        // the object may already be owned, the new handle joins its ring
+    template<class S> intrusive_linked_ptr(S* data);
+    template<class S> intrusive_linked_ptr(intrusive_linked_ptr<S> const& rhs);
+    template<class S> intrusive_linked_ptr<T> const& operator=(intrusive_linked_ptr<S> const& rhs);
+
+    void reset();
+    void reset(T* data);
+
+    T* get();
+    T const* get() const;
+
+    bool unique() const;
+        // care!! Complexity is linear of the count
+    long use_count() const;
+
+    T& operator*();
+    T const& operator*() const;
+    T* operator->();
+    T const* operator->() const;
+
+    operator bool_type() const;
+
+    void swap(intrusive_linked_ptr<T>& rhs);
+
+private:
+    T* mData{ nullptr };
+    mutable list_node mNode;
+
+    list_node& anchor() const;
+
+    void bool_test_function() const;
+
+    template<class S>
+    friend class intrusive_linked_ptr;
+};
+
+
+template<class T, class... Args>
+intrusive_linked_ptr<T> make_intrusive_linked(Args&&... args);
+
+
+template<class T>
+bool operator==(const intrusive_linked_ptr<T>& left, const intrusive_linked_ptr<T>& right);
+template<class T>
+bool operator!=(const intrusive_linked_ptr<T>& left, const intrusive_linked_ptr<T>& right);
+template<class T>
+bool operator<(const intrusive_linked_ptr<T>& left, const intrusive_linked_ptr<T>& right);
+
+#include "intrusive_linked_ptr.hpp"
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef SMART_POINTERS_INTRUSIVE_LINKED_PTR_CPP
+#define SMART_POINTERS_INTRUSIVE_LINKED_PTR_CPP
+
+#include <utility> // for swap
+
+/*********************************************************/
+/*                      linked_hook                      */
+
+inline linked_hook::linked_hook()
+{
+}
+
+inline linked_hook::linked_hook(linked_hook const&)
+{
+}
+
+inline linked_hook& linked_hook::operator=(linked_hook const&)
+{
+    return *this;
+}
+
+inline linked_hook::~linked_hook()
+{
+}
+
+/*********************************************************/
+/*                 intrusive_linked_ptr                  */
+
+template<class T>
+intrusive_linked_ptr<T>::intrusive_linked_ptr()
+{
+}
+
+template<class T>
+intrusive_linked_ptr<T>::intrusive_linked_ptr(intrusive_linked_ptr<T> const& rhs)
+    : mData(rhs.mData)
+{
+    if (mData)
+        mNode.link(rhs.mNode);
+}
+
+template<class T>
+intrusive_linked_ptr<T> const& intrusive_linked_ptr<T>::operator=(intrusive_linked_ptr<T> const& rhs)
+{
+    if (mData != rhs.mData)
+    {
+        this_type(rhs).swap(*this);
+    }
+    return *this;
+}
+
+template<class T>
+intrusive_linked_ptr<T>::intrusive_linked_ptr(intrusive_linked_ptr<T>&& rhs) noexcept
+    : mData(rhs.mData)
+    , mNode(std::move(rhs.mNode))
+{
+    rhs.mData = nullptr;
+}
+
+template<class T>
+intrusive_linked_ptr<T> const& intrusive_linked_ptr<T>::operator=(intrusive_linked_ptr<T>&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        this_type(std::move(rhs)).swap(*this);
+    }
+    return *this;
+}
+
+template<class T>
+intrusive_linked_ptr<T>::~intrusive_linked_ptr()
+{
+    reset();
+}
+
+template<class T>
+template<class S>
+intrusive_linked_ptr<T>::intrusive_linked_ptr(S* data)
+    : mData(data)
+{
+    if (mData)
+        mNode.link(anchor());
+}
+
+template<class T>
+template<class S>
+intrusive_linked_ptr<T>::intrusive_linked_ptr(intrusive_linked_ptr<S> const& rhs)
+    : mData(rhs.mData)
+{
+    if (mData)
+        mNode.link(rhs.mNode);
+}
+
+template<class T>
+template<class S>
+intrusive_linked_ptr<T> const& intrusive_linked_ptr<T>::operator=(intrusive_linked_ptr<S> const& rhs)
+{
+    if (mData != rhs.mData)
+    {
+        this_type(rhs).swap(*this);
+    }
+    return *this;
+}
+
+template<class T>
+void intrusive_linked_ptr<T>::reset()
+{
+    if (mData)
+    {
+        bool const last = mNode.alone_with(anchor());
+        mNode.unlink();
+        if (last)
+            delete mData;
+    }
+    mData = nullptr;
+}
+
+template<class T>
+void intrusive_linked_ptr<T>::reset(T* data)
+{
+    this_type(data).swap(*this);
+}
+
+template<class T>
+T* intrusive_linked_ptr<T>::get()
+{
+    return mData;
+}
+
+template<class T>
+T const* intrusive_linked_ptr<T>::get() const
+{
+    return mData;
+}
+
+template<class T>
+bool intrusive_linked_ptr<T>::unique() const
+{
+    return mData != nullptr && mNode.alone_with(anchor());
+}
+
+template<class T>
+long intrusive_linked_ptr<T>::use_count() const
+{
+    if (!mData)
+        return 0;
+        // every member of the ring but the anchor
+    return anchor().use_count() - 1;
+}
+
+template<class T>
+T& intrusive_linked_ptr<T>::operator*()
+{
+    return *mData;
+}
+
+template<class T>
+T const& intrusive_linked_ptr<T>::operator*() const
+{
+    return *mData;
+}
+
+template<class T>
+T* intrusive_linked_ptr<T>::operator->()
+{
+    return mData;
+}
+
+template<class T>
+T const* intrusive_linked_ptr<T>::operator->() const
+{
+    return mData;
+}
+
+template<class T>
+void intrusive_linked_ptr<T>::swap(intrusive_linked_ptr<T>& rhs)
+{
+    if (mData != rhs.mData)
+    {
+        std::swap(mData, rhs.mData);
+        mNode.swap(rhs.mNode);
+    }
+}
+
+template<class T>
+list_node& intrusive_linked_ptr<T>::anchor() const
+{
+    return static_cast<linked_hook const*>(mData)->mAnchor;
+}
+
+template<class T>
+void intrusive_linked_ptr<T>::bool_test_function() const
+{
+}
+
+template<class T>
+intrusive_linked_ptr<T>::operator bool_type() const
+{
+    return mData != nullptr ? &intrusive_linked_ptr<T>::bool_test_function : nullptr;
+}
+
+
+template<class T, class... Args>
+intrusive_linked_ptr<T> make_intrusive_linked(Args&&... args)
+{
+    return intrusive_linked_ptr<T>(new T(std::forward<Args>(args)...));
+}
+
+
+template<class T>
+bool operator==(intrusive_linked_ptr<T> const& left, intrusive_linked_ptr<T> const& right)
+{
+    return left.get() == right.get();
+}
+
+template<class T>
+bool operator!=(intrusive_linked_ptr<T> const& left, intrusive_linked_ptr<T> const& right)
+{
+    return !(left == right);
+}
+
+template<class T>
+bool operator<(intrusive_linked_ptr<T> const& left, intrusive_linked_ptr<T> const& right)
+{
+    return left.get() < right.get();
+}
+
+#endif
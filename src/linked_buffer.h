@@ -0,0 +1,57 @@
+#ifndef SMART_POINTERS_LINKED_BUFFER_H
+#define SMART_POINTERS_LINKED_BUFFER_H
+#include <cstddef>
+#include "linked_ptr.h"
+
+
+    // bytes of a shared buffer: a pointer into it, the length of
+    // the view and a place in the ring of the buffer's owners.
+    // Slices join the same ring, nothing is copied or allocated
+class linked_buffer
+{
+public:
+    linked_buffer();
+        // allocates size zeroed bytes with make_linked<char[]>
+    explicit linked_buffer(std::size_t size);
+    linked_buffer(linked_ptr<char[]> storage, std::size_t size);
+        // size bytes from data, kept alive by owner
+    template<class S>
+    linked_buffer(linked_ptr<S> const& owner, char* data, std::size_t size);
+
+        // shares the buffer from offset on. The range is clipped
+        // to this view: it's empty when offset is past the end
+    linked_buffer slice(std::size_t offset, std::size_t length) const;
+    linked_buffer slice(std::size_t offset) const;
+
+    void reset();
+
+    char* data();
+    char const* data() const;
+    std::size_t size() const;
+    bool empty() const;
+
+    char* begin();
+    char const* begin() const;
+    char* end();
+    char const* end() const;
+
+    char& operator[](std::size_t index);
+    char const& operator[](std::size_t index) const;
+
+    bool unique() const;
+        // care!! Complexity is linear of the count
+    long use_count() const;
+
+    void swap(linked_buffer& rhs);
+
+private:
+    linked_ptr<char> mData;
+    std::size_t mSize{ 0 };
+};
+
+
+void swap(linked_buffer& left, linked_buffer& right);
+
+#include "linked_buffer.hpp"
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef SMART_POINTERS_LINKED_BUFFER_CPP
+#define SMART_POINTERS_LINKED_BUFFER_CPP
+
+#include <algorithm> // for min
+#include <utility> // for move
+
+/*********************************************************/
+/*                     linked_buffer                     */
+
+inline linked_buffer::linked_buffer()
+{
+}
+
+inline linked_buffer::linked_buffer(std::size_t size)
+    : linked_buffer(make_linked<char[]>(size), size)
+{
+}
+
+inline linked_buffer::linked_buffer(linked_ptr<char[]> storage, std::size_t size)
+    : mData(std::move(storage), storage.get())
+    , mSize(mData ? size : 0)
+{
+}
+
+template<class S>
+linked_buffer::linked_buffer(linked_ptr<S> const& owner, char* data, std::size_t size)
+    : mData(owner, data)
+    , mSize(data != nullptr ? size : 0)
+{
+}
+
+inline linked_buffer linked_buffer::slice(std::size_t offset, std::size_t length) const
+{
+        // the slice shares the bytes, constness of the view isn't deep
+    char* first = const_cast<char*>(mData.get());
+    offset = std::min(offset, mSize);
+    return linked_buffer(mData, first + offset, std::min(length, mSize - offset));
+}
+
+inline linked_buffer linked_buffer::slice(std::size_t offset) const
+{
+    return slice(offset, mSize);
+}
+
+inline void linked_buffer::reset()
+{
+    mData.reset();
+    mSize = 0;
+}
+
+inline char* linked_buffer::data()
+{
+    return mData.get();
+}
+
+inline char const* linked_buffer::data() const
+{
+    return mData.get();
+}
+
+inline std::size_t linked_buffer::size() const
+{
+    return mSize;
+}
+
+inline bool linked_buffer::empty() const
+{
+    return mSize == 0;
+}
+
+inline char* linked_buffer::begin()
+{
+    return mData.get();
+}
+
+inline char const* linked_buffer::begin() const
+{
+    return mData.get();
+}
+
+inline char* linked_buffer::end()
+{
+    return mData.get() + mSize;
+}
+
+inline char const* linked_buffer::end() const
+{
+    return mData.get() + mSize;
+}
+
+inline char& linked_buffer::operator[](std::size_t index)
+{
+    return mData.get()[index];
+}
+
+inline char const& linked_buffer::operator[](std::size_t index) const
+{
+    return mData.get()[index];
+}
+
+inline bool linked_buffer::unique() const
+{
+    return mData.unique();
+}
+
+inline long linked_buffer::use_count() const
+{
+    return mData.use_count();
+}
+
+inline void linked_buffer::swap(linked_buffer& rhs)
+{
+    mData.swap(rhs.mData);
+    std::swap(mSize, rhs.mSize);
+}
+
+
+inline void swap(linked_buffer& left, linked_buffer& right)
+{
+    left.swap(right);
+}
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef SMART_POINTERS_LINKED_FLAT_TABLE_H
+#define SMART_POINTERS_LINKED_FLAT_TABLE_H
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include "linked_ptr.h"
+
+
+    // walks the occupied slots of a linked_flat_table
+template<class V>
+class linked_flat_iterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<V>::type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef V* pointer;
+    typedef V& reference;
+
+    linked_flat_iterator();
+    linked_flat_iterator(std::uint8_t const* control, V* slots, std::size_t index, std::size_t capacity);
+    operator linked_flat_iterator<V const>() const;
+
+    V& operator*() const;
+    V* operator->() const;
+    linked_flat_iterator<V>& operator++();
+    linked_flat_iterator<V> operator++(int);
+
+    bool operator==(linked_flat_iterator<V> const& rhs) const;
+    bool operator!=(linked_flat_iterator<V> const& rhs) const;
+
+private:
+    void skip_empty();
+
+    std::uint8_t const* mControl{ nullptr };
+    V* mSlots{ nullptr };
+    std::size_t mIndex{ 0 };
+    std::size_t mCapacity{ 0 };
+};
+
+    // open addressing table of linked_ptr's with linear probing.
+    // A control byte per slot keeps a few bits of the hash, most probes
+    // don't touch the slot itself. Erasing shifts the following slots
+    // back, there are no tombstones.
+    // Slots are moved when the table grows or shifts: moving a linked_ptr
+    // takes the place of the old node in its ring, constant time, the ring
+    // never sees a copy. Empty pointers aren't stored
+template<class T, class Slot>
+class linked_flat_table
+{
+public:
+    typedef Slot value_type;
+    typedef typename linked_ptr<T>::element_type element_type;
+    typedef linked_flat_iterator<Slot> iterator;
+    typedef linked_flat_iterator<Slot const> const_iterator;
+
+    linked_flat_table();
+    linked_flat_table(linked_flat_table<T, Slot> const& rhs);
+    linked_flat_table(linked_flat_table<T, Slot>&& rhs) noexcept;
+    linked_flat_table<T, Slot>& operator=(linked_flat_table<T, Slot> rhs);
+    ~linked_flat_table();
+
+    iterator begin();
+    const_iterator begin() const;
+    iterator end();
+    const_iterator end() const;
+
+    std::size_t size() const;
+    bool empty() const;
+    std::size_t capacity() const;
+
+        // key is a raw pointer or any linked_ptr,
+        // no handle joins the ring of the element
+    template<class K> iterator find(K const& key);
+    template<class K> const_iterator find(K const& key) const;
+    template<class K> bool contains(K const& key) const;
+    template<class K> std::size_t erase(K const& key);
+
+    void clear();
+        // room for count elements without growing
+    void reserve(std::size_t count);
+
+    void swap(linked_flat_table<T, Slot>& rhs);
+
+protected:
+        // slot made of args for key, unless key is already there
+    template<class... Args>
+    std::pair<iterator, bool> emplace_key(element_type const* key, Args&&... args);
+
+private:
+    static std::uint64_t mix(void const* key);
+    static std::uint8_t tag(std::uint64_t hash);
+
+    std::size_t locate(element_type const* key) const;
+    void rehash(std::size_t capacity);
+    void release();
+
+    std::uint8_t* mControl{ nullptr };
+    Slot* mSlots{ nullptr };
+    std::size_t mCapacity{ 0 };
+    std::size_t mSize{ 0 };
+};
+
+template<class T>
+class linked_ptr_flat_set : public linked_flat_table<T, linked_ptr<T>>
+{
+private:
+    typedef linked_flat_table<T, linked_ptr<T>> base_type;
+
+public:
+    typedef typename base_type::iterator iterator;
+
+    std::pair<iterator, bool> insert(linked_ptr<T> const& ptr);
+    std::pair<iterator, bool> insert(linked_ptr<T>&& ptr);
+};
+
+    // care!! The key of an element must not be changed through
+    // an iterator, the table wouldn't find it anymore
+template<class K, class V>
+class linked_ptr_flat_map : public linked_flat_table<K, std::pair<linked_ptr<K>, V>>
+{
+private:
+    typedef linked_flat_table<K, std::pair<linked_ptr<K>, V>> base_type;
+
+public:
+    typedef typename base_type::iterator iterator;
+
+    std::pair<iterator, bool> insert(linked_ptr<K> const& key, V value);
+    std::pair<iterator, bool> insert(linked_ptr<K>&& key, V value);
+        // default constructed value when key isn't there yet.
+        // care!! key must not be empty
+    V& operator[](linked_ptr<K> const& key);
+};
+
+
+template<class T, class Slot>
+void swap(linked_flat_table<T, Slot>& left, linked_flat_table<T, Slot>& right);
+
+#include "linked_flat_table.hpp"
+
+#endif
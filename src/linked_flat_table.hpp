@@ -0,0 +1,411 @@
+#ifndef SMART_POINTERS_LINKED_FLAT_TABLE_CPP
+#define SMART_POINTERS_LINKED_FLAT_TABLE_CPP
+
+#include <cstring> // for memset
+#include <memory> // for allocator
+#include <new>
+#include <tuple> // for forward_as_tuple
+
+/*********************************************************/
+/*                 linked_flat_iterator                  */
+
+template<class V>
+linked_flat_iterator<V>::linked_flat_iterator()
+{
+}
+
+template<class V>
+linked_flat_iterator<V>::linked_flat_iterator(std::uint8_t const* control, V* slots, std::size_t index, std::size_t capacity)
+    : mControl(control)
+    , mSlots(slots)
+    , mIndex(index)
+    , mCapacity(capacity)
+{
+    skip_empty();
+}
+
+template<class V>
+linked_flat_iterator<V>::operator linked_flat_iterator<V const>() const
+{
+    return linked_flat_iterator<V const>(mControl, mSlots, mIndex, mCapacity);
+}
+
+template<class V>
+V& linked_flat_iterator<V>::operator*() const
+{
+    return mSlots[mIndex];
+}
+
+template<class V>
+V* linked_flat_iterator<V>::operator->() const
+{
+    return mSlots + mIndex;
+}
+
+template<class V>
+linked_flat_iterator<V>& linked_flat_iterator<V>::operator++()
+{
+    ++mIndex;
+    skip_empty();
+    return *this;
+}
+
+template<class V>
+linked_flat_iterator<V> linked_flat_iterator<V>::operator++(int)
+{
+    linked_flat_iterator<V> it(*this);
+    ++*this;
+    return it;
+}
+
+template<class V>
+bool linked_flat_iterator<V>::operator==(linked_flat_iterator<V> const& rhs) const
+{
+    return mSlots == rhs.mSlots && mIndex == rhs.mIndex;
+}
+
+template<class V>
+bool linked_flat_iterator<V>::operator!=(linked_flat_iterator<V> const& rhs) const
+{
+    return !(*this == rhs);
+}
+
+template<class V>
+void linked_flat_iterator<V>::skip_empty()
+{
+    while (mIndex < mCapacity && mControl[mIndex] == 0)
+        ++mIndex;
+}
+
+/*********************************************************/
+/*                  linked_flat_table                    */
+
+    // key of a map slot
+template<class T, class V>
+typename linked_ptr<T>::element_type const* linked_key(std::pair<linked_ptr<T>, V> const& slot)
+{
+    return slot.first.get();
+}
+
+template<class T, class V>
+void prefetch_ring(std::pair<linked_ptr<T>, V> const& slot)
+{
+    prefetch_ring(slot.first);
+}
+
+template<class T, class Slot>
+linked_flat_table<T, Slot>::linked_flat_table()
+{
+}
+
+template<class T, class Slot>
+linked_flat_table<T, Slot>::linked_flat_table(linked_flat_table<T, Slot> const& rhs)
+{
+    reserve(rhs.size());
+    for (Slot const& slot : rhs)
+        emplace_key(linked_key(slot), slot);
+}
+
+template<class T, class Slot>
+linked_flat_table<T, Slot>::linked_flat_table(linked_flat_table<T, Slot>&& rhs) noexcept
+    : mControl(rhs.mControl)
+    , mSlots(rhs.mSlots)
+    , mCapacity(rhs.mCapacity)
+    , mSize(rhs.mSize)
+{
+    rhs.mControl = nullptr;
+    rhs.mSlots = nullptr;
+    rhs.mCapacity = 0;
+    rhs.mSize = 0;
+}
+
+template<class T, class Slot>
+linked_flat_table<T, Slot>& linked_flat_table<T, Slot>::operator=(linked_flat_table<T, Slot> rhs)
+{
+    swap(rhs);
+    return *this;
+}
+
+template<class T, class Slot>
+linked_flat_table<T, Slot>::~linked_flat_table()
+{
+    release();
+}
+
+template<class T, class Slot>
+typename linked_flat_table<T, Slot>::iterator linked_flat_table<T, Slot>::begin()
+{
+    return iterator(mControl, mSlots, 0, mCapacity);
+}
+
+template<class T, class Slot>
+typename linked_flat_table<T, Slot>::const_iterator linked_flat_table<T, Slot>::begin() const
+{
+    return const_iterator(mControl, mSlots, 0, mCapacity);
+}
+
+template<class T, class Slot>
+typename linked_flat_table<T, Slot>::iterator linked_flat_table<T, Slot>::end()
+{
+    return iterator(mControl, mSlots, mCapacity, mCapacity);
+}
+
+template<class T, class Slot>
+typename linked_flat_table<T, Slot>::const_iterator linked_flat_table<T, Slot>::end() const
+{
+    return const_iterator(mControl, mSlots, mCapacity, mCapacity);
+}
+
+template<class T, class Slot>
+std::size_t linked_flat_table<T, Slot>::size() const
+{
+    return mSize;
+}
+
+template<class T, class Slot>
+bool linked_flat_table<T, Slot>::empty() const
+{
+    return mSize == 0;
+}
+
+template<class T, class Slot>
+std::size_t linked_flat_table<T, Slot>::capacity() const
+{
+    return mCapacity;
+}
+
+template<class T, class Slot>
+template<class K>
+typename linked_flat_table<T, Slot>::iterator linked_flat_table<T, Slot>::find(K const& key)
+{
+    return iterator(mControl, mSlots, locate(linked_key(key)), mCapacity);
+}
+
+template<class T, class Slot>
+template<class K>
+typename linked_flat_table<T, Slot>::const_iterator linked_flat_table<T, Slot>::find(K const& key) const
+{
+    return const_iterator(mControl, mSlots, locate(linked_key(key)), mCapacity);
+}
+
+template<class T, class Slot>
+template<class K>
+bool linked_flat_table<T, Slot>::contains(K const& key) const
+{
+    return locate(linked_key(key)) != mCapacity;
+}
+
+template<class T, class Slot>
+template<class K>
+std::size_t linked_flat_table<T, Slot>::erase(K const& key)
+{
+    std::size_t hole = locate(linked_key(key));
+    if (hole == mCapacity)
+        return 0;
+        // the element is destroyed once the table is consistent again,
+        // its destructor may look into the table
+    Slot removed(std::move(mSlots[hole]));
+    mSlots[hole].~Slot();
+    --mSize;
+        // following slots move back into the hole
+        // unless it would put them before their home slot
+    std::size_t const mask = mCapacity - 1;
+    std::size_t it = (hole + 1) & mask;
+    while (mControl[it] != 0)
+    {
+        std::size_t const home = static_cast<std::size_t>(mix(linked_key(mSlots[it]))) & mask;
+        if (((it - home) & mask) >= ((it - hole) & mask))
+        {
+            new (mSlots + hole) Slot(std::move(mSlots[it]));
+            mSlots[it].~Slot();
+            mControl[hole] = mControl[it];
+            hole = it;
+        }
+        it = (it + 1) & mask;
+    }
+    mControl[hole] = 0;
+    return 1;
+}
+
+template<class T, class Slot>
+void linked_flat_table<T, Slot>::clear()
+{
+    for (std::size_t i = 0; i < mCapacity; ++i)
+    {
+        if (mControl[i] != 0)
+        {
+            mSlots[i].~Slot();
+            mControl[i] = 0;
+        }
+    }
+    mSize = 0;
+}
+
+template<class T, class Slot>
+void linked_flat_table<T, Slot>::reserve(std::size_t count)
+{
+    std::size_t capacity = mCapacity != 0 ? mCapacity : 16;
+    while (count * 4 > capacity * 3)
+        capacity *= 2;
+    if (capacity != mCapacity)
+        rehash(capacity);
+}
+
+template<class T, class Slot>
+void linked_flat_table<T, Slot>::swap(linked_flat_table<T, Slot>& rhs)
+{
+    std::swap(mControl, rhs.mControl);
+    std::swap(mSlots, rhs.mSlots);
+    std::swap(mCapacity, rhs.mCapacity);
+    std::swap(mSize, rhs.mSize);
+}
+
+template<class T, class Slot>
+template<class... Args>
+std::pair<typename linked_flat_table<T, Slot>::iterator, bool> linked_flat_table<T, Slot>::emplace_key(element_type const* key, Args&&... args)
+{
+    if (key == nullptr)
+        return std::make_pair(end(), false);
+    if ((mSize + 1) * 4 > mCapacity * 3)
+        reserve(mSize + 1);
+    std::uint64_t const hash = mix(key);
+    std::uint8_t const control = tag(hash);
+    std::size_t const mask = mCapacity - 1;
+    std::size_t it = static_cast<std::size_t>(hash) & mask;
+    while (mControl[it] != 0)
+    {
+        if (mControl[it] == control && linked_key(mSlots[it]) == key)
+            return std::make_pair(iterator(mControl, mSlots, it, mCapacity), false);
+        it = (it + 1) & mask;
+    }
+    new (mSlots + it) Slot(std::forward<Args>(args)...);
+    mControl[it] = control;
+    ++mSize;
+    return std::make_pair(iterator(mControl, mSlots, it, mCapacity), true);
+}
+
+template<class T, class Slot>
+std::uint64_t linked_flat_table<T, Slot>::mix(void const* key)
+{
+        // objects are aligned and often allocated next to each other,
+        // the low bits alone would pile them up in a few slots
+    std::uint64_t hash = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(key));
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+template<class T, class Slot>
+std::uint8_t linked_flat_table<T, Slot>::tag(std::uint64_t hash)
+{
+        // never 0, that marks an empty slot
+    return static_cast<std::uint8_t>(0x80 | (hash >> 57));
+}
+
+template<class T, class Slot>
+std::size_t linked_flat_table<T, Slot>::locate(element_type const* key) const
+{
+    if (key == nullptr || mSize == 0)
+        return mCapacity;
+    std::uint64_t const hash = mix(key);
+    std::uint8_t const control = tag(hash);
+    std::size_t const mask = mCapacity - 1;
+    std::size_t it = static_cast<std::size_t>(hash) & mask;
+    while (mControl[it] != 0)
+    {
+        if (mControl[it] == control && linked_key(mSlots[it]) == key)
+            return it;
+        it = (it + 1) & mask;
+    }
+    return mCapacity;
+}
+
+template<class T, class Slot>
+void linked_flat_table<T, Slot>::rehash(std::size_t capacity)
+{
+    std::uint8_t* control = new std::uint8_t[capacity];
+    std::memset(control, 0, capacity);
+    Slot* slots = std::allocator<Slot>().allocate(capacity);
+    std::size_t const mask = capacity - 1;
+        // every move rewrites the ring neighbours of the slot, they're
+        // scattered all over: the ones a few slots ahead are fetched
+        // while the current slot is moved
+    std::size_t const AHEAD = 16;
+    for (std::size_t i = 0; i < mCapacity; ++i)
+    {
+        if (i + AHEAD < mCapacity && mControl[i + AHEAD] != 0)
+            prefetch_ring(mSlots[i + AHEAD]);
+        if (mControl[i] == 0)
+            continue;
+        std::uint64_t const hash = mix(linked_key(mSlots[i]));
+        std::size_t it = static_cast<std::size_t>(hash) & mask;
+        while (control[it] != 0)
+            it = (it + 1) & mask;
+        new (slots + it) Slot(std::move(mSlots[i]));
+        mSlots[i].~Slot();
+        control[it] = mControl[i];
+    }
+    std::size_t const size = mSize;
+    mSize = 0;
+    release();
+    mControl = control;
+    mSlots = slots;
+    mCapacity = capacity;
+    mSize = size;
+}
+
+template<class T, class Slot>
+void linked_flat_table<T, Slot>::release()
+{
+    if (mSize != 0)
+        clear();
+    if (mSlots != nullptr)
+        std::allocator<Slot>().deallocate(mSlots, mCapacity);
+    delete[] mControl;
+    mControl = nullptr;
+    mSlots = nullptr;
+    mCapacity = 0;
+}
+
+/*********************************************************/
+/*            linked_ptr_flat_set and _map               */
+
+template<class T>
+std::pair<typename linked_ptr_flat_set<T>::iterator, bool> linked_ptr_flat_set<T>::insert(linked_ptr<T> const& ptr)
+{
+    return this->emplace_key(ptr.get(), ptr);
+}
+
+template<class T>
+std::pair<typename linked_ptr_flat_set<T>::iterator, bool> linked_ptr_flat_set<T>::insert(linked_ptr<T>&& ptr)
+{
+    return this->emplace_key(ptr.get(), std::move(ptr));
+}
+
+template<class K, class V>
+std::pair<typename linked_ptr_flat_map<K, V>::iterator, bool> linked_ptr_flat_map<K, V>::insert(linked_ptr<K> const& key, V value)
+{
+    return this->emplace_key(key.get(), key, std::move(value));
+}
+
+template<class K, class V>
+std::pair<typename linked_ptr_flat_map<K, V>::iterator, bool> linked_ptr_flat_map<K, V>::insert(linked_ptr<K>&& key, V value)
+{
+    return this->emplace_key(key.get(), std::move(key), std::move(value));
+}
+
+template<class K, class V>
+V& linked_ptr_flat_map<K, V>::operator[](linked_ptr<K> const& key)
+{
+    return this->emplace_key(key.get(), std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first->second;
+}
+
+
+template<class T, class Slot>
+void swap(linked_flat_table<T, Slot>& left, linked_flat_table<T, Slot>& right)
+{
+    left.swap(right);
+}
+
+#endif
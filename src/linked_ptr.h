@@ -1,6 +1,9 @@
 #ifndef SMART_POINTERS_LINKED_PTR_H
 #define SMART_POINTERS_LINKED_PTR_H
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <type_traits>
 
 
 struct list_node
@@ -9,23 +12,110 @@ struct list_node
     ~list_node();
     list_node(list_node& rhs);
     list_node const& operator=(list_node& rhs);
+    list_node(list_node&& rhs) noexcept;
+    list_node const& operator=(list_node&& rhs) noexcept;
 
     void link(list_node&);
+        // joins the list of rhs as a non-owning member.
+        // Weak members are kept behind all the owners, so it walks
+        // past the owners that follow rhs
+    void link_weak(list_node& rhs);
+        // takes the place of rhs in its list, rhs is left unlinked
+    void take(list_node& rhs) noexcept;
 
+        // the last owner to unlink leaves the weak members on their own
     void unlink();
+        // no other owners in the list, weak members aren't counted
     bool unique() const;
         // care!! Complexity is linear of the count
     long use_count() const;
+        // rhs is the only other member of the list and follows this one
+    bool alone_with(list_node const& rhs) const;
 
     void swap(list_node& rhs);
 
+    bool weak() const;
+        // weak member whose owners are all gone
+    bool expired() const;
+        // closest owner in front of a weak member
+    list_node* find_owner() const;
+
+    list_node* prev_node() const;
+    list_node* next_node() const;
+
 private:
-        //links to next and previous ptrs in list
+    static std::uintptr_t const WEAK_FLAG = 1;
+
+    void set_prev(list_node* node);
+
+        //links to next and previous ptrs in list,
+        //the lowest bit of prev marks a weak member
     list_node* next{ nullptr };
-    list_node* prev{ nullptr };
+    std::uintptr_t prev{ 0 };
 };
 
 struct custom_deleter_base;
+struct deleter_descriptor;
+
+template<class T>
+class weak_linked_ptr;
+template<class T>
+class enable_linked_from_this;
+
+    // knows how to release the owned object, copied to every owner
+    // and weak pointer. It takes a single word: default delete and
+    // stateless deleters (empty functors, std::default_delete) point
+    // to a static descriptor of their type and release the pointer the
+    // handle holds. Stateful deleters, make_linked and handles pointing
+    // elsewhere than the owned object use a heap block that keeps the
+    // owned pointer, shared by the handles referring to it.
+    // held is the pointer of the handle the storage belongs to
+class deleter_storage
+{
+public:
+    deleter_storage();
+    deleter_storage(deleter_storage const& rhs);
+    deleter_storage const& operator=(deleter_storage const& rhs);
+    deleter_storage(deleter_storage&& rhs) noexcept;
+    deleter_storage const& operator=(deleter_storage&& rhs) noexcept;
+    ~deleter_storage();
+
+        // care!! data is released when the storage can't be made
+    template<class S> deleter_storage(S* data, void const* held);
+    template<class S, class D> deleter_storage(S* data, D deleter, void const* held);
+        // releases data with delete[]
+    template<class S> static deleter_storage for_array(S* data, void const* held);
+        // block holding both the object and its deleter
+    static deleter_storage from_block(void const* owned, custom_deleter_base* block);
+
+        // same owner, for a handle holding alias instead of held
+    deleter_storage rebind(void const* held, void const* alias) const;
+
+        // releases the owned object, does nothing if there is none
+    void destroy(void const* held) const;
+    void* owned(void const* held) const;
+
+private:
+    static std::uintptr_t const BLOCK_FLAG = 1;
+
+    template<class D>
+    struct is_stateless : std::integral_constant<bool,
+        std::is_empty<D>::value && std::is_trivially_copyable<D>::value>
+    {
+    };
+
+    template<class S, class D> void store(S* data, D deleter, void const* held, std::true_type);
+    template<class S, class D> void store(S* data, D deleter, void const* held, std::false_type);
+    void attach(deleter_descriptor const* descriptor, void const* owned, void const* held);
+    void attach(custom_deleter_base* block, void const* owned);
+    void release();
+
+    deleter_descriptor const* descriptor() const;
+    custom_deleter_base* block() const;
+
+        // descriptor, or block with BLOCK_FLAG set
+    std::uintptr_t mValue{ 0 };
+};
 
 template<class T>
 class linked_ptr
@@ -34,21 +124,43 @@ private:
     typedef void (linked_ptr<T>::*bool_type)() const;
     typedef linked_ptr<T> this_type;
 
+        // T[] takes pointers to its own element type only, up to cv,
+        // delete[] through a pointer to a base is undefined
+    template<class S>
+    struct accepts_pointer : std::integral_constant<bool, !std::is_array<T>::value
+        || std::is_convertible<S(*)[], typename std::remove_extent<T>::type(*)[]>::value>
+    {
+    };
+
 public:
+        // T[] owns an array: the pointer is to its first element
+        // and the array is released with delete[]
+    typedef typename std::remove_extent<T>::type element_type;
+
     linked_ptr();
 
     linked_ptr(linked_ptr<T> const& rhs);
     linked_ptr<T> const& operator=(linked_ptr<T> const& rhs);
 
-    linked_ptr(linked_ptr<T>&& rhs);
-    linked_ptr<T> const& operator=(linked_ptr<T>&& rhs);
+    linked_ptr(linked_ptr<T>&& rhs) noexcept;
+    linked_ptr<T> const& operator=(linked_ptr<T>&& rhs) noexcept;
 
     ~linked_ptr();
 
-    template<class S> linked_ptr(S* data);
+    template<class S, class = typename std::enable_if<accepts_pointer<S>::value>::type>
+    linked_ptr(S* data);
     template<class S> linked_ptr(linked_ptr<S> const& rhs);
     template<class S> linked_ptr<T> const& operator=(linked_ptr<S> const& rhs);
-    template<class S, class D> linked_ptr(S* data, D deleter);
+        // care!! Conversions and aliasing that move the pointer away
+        // from the owned object allocate a small block when the deleter
+        // has none, the source is left alone if that fails
+    template<class S> linked_ptr(linked_ptr<S>&& rhs);
+        // aliasing: joins the ring of owner, but points to data,
+        // usually a part of the owner's object
+    template<class S> linked_ptr(linked_ptr<S> const& owner, element_type* data);
+    template<class S> linked_ptr(linked_ptr<S>&& owner, element_type* data);
+    template<class S, class D, class = typename std::enable_if<accepts_pointer<S>::value>::type>
+    linked_ptr(S* data, D deleter);
 
     template<class S> linked_ptr(std::auto_ptr<S>&& rhs);
     template<class S, class D> linked_ptr(std::unique_ptr<S, D>&& rhs);
@@ -57,48 +169,312 @@ public:
     template<class S, class D> linked_ptr const& operator=(std::unique_ptr<S, D>&& rhs);
 
     void reset();
-    void reset(T* data);
+    void reset(element_type* data);
     template<class D>
-    void reset(T* data, D d);
+    void reset(element_type* data, D d);
+    template<class S, class = typename std::enable_if<!accepts_pointer<S>::value>::type>
+    void reset(S* data) = delete;
+    template<class S, class D, class = typename std::enable_if<!accepts_pointer<S>::value>::type>
+    void reset(S* data, D d) = delete;
 
-    T* get();
-    T const* get() const;
+    element_type* get();
+    element_type const* get() const;
 
     bool unique() const;
     long use_count() const;
 
-    T& operator*();
-    T const& operator*() const;
-    T* operator->();
-    T const* operator->() const;
+    element_type& operator*();
+    element_type const& operator*() const;
+        // operator-> for single objects, operator[] for arrays
+    template<class U = T>
+    typename std::enable_if<!std::is_array<U>::value, element_type*>::type operator->();
+    template<class U = T>
+    typename std::enable_if<!std::is_array<U>::value, element_type const*>::type operator->() const;
+    template<class U = T>
+    typename std::enable_if<std::is_array<U>::value, element_type&>::type operator[](std::size_t index);
+    template<class U = T>
+    typename std::enable_if<std::is_array<U>::value, element_type const&>::type operator[](std::size_t index) const;
 
     operator bool_type() const;
 
     void swap(linked_ptr<T>& rhs);
 
+        // order of the owned objects rather than of the pointed ones,
+        // aliases of the same owner are equivalent
+    template<class S> bool owner_before(linked_ptr<S> const& rhs) const;
+    template<class S> bool owner_before(weak_linked_ptr<S> const& rhs) const;
+
 private:
-    T* mData{ nullptr };
+    element_type* mData{ nullptr };
     mutable list_node mNode;
-    custom_deleter_base* mDeleter{ nullptr };
+    deleter_storage mDeleter;
+
+        // delete or delete[], whichever matches T
+    template<class S>
+    static deleter_storage default_deleter(S* data, void const* held);
+        // the object the deleter releases
+    void* owned() const;
+
+        // a new owner of an object derived from enable_linked_from_this
+        // leaves it a weak pointer to the ring, if it has none yet
+    template<class U>
+    void share_this(enable_linked_from_this<U> const* base);
+    void share_this(void const volatile*);
+
+        // points to the same object and shares the ring with rhs
+    template<class S>
+    bool same_view(linked_ptr<S> const& rhs) const;
 
-    typedef void (linked_ptr<T>::*bool_type)() const;
     void bool_test_function() const;
 
     template<class S>
     friend class linked_ptr;
+    template<class S, class P>
+    friend class concurrent_linked_ptr;
+    template<class S>
+    friend class weak_linked_ptr;
+    template<class S, class... Args>
+    friend linked_ptr<S> make_linked(Args&&... args);
+    template<class S, class A, class... Args>
+    friend linked_ptr<S> allocate_linked(A const& alloc, Args&&... args);
+    template<class S>
+    friend void destroy_range(linked_ptr<S>* first, linked_ptr<S>* last);
+    template<class S>
+    friend void prefetch_ring(linked_ptr<S> const& ptr);
+    template<class S>
+    friend class borrowed_linked_ptr;
 };
 
 
+    // observes the object of linked_ptr's without owning it: joins their
+    // ring as a weak member, lock() gives back an owning pointer
+    // while there still are owners
+template<class T>
+class weak_linked_ptr
+{
+private:
+    typedef weak_linked_ptr<T> this_type;
+
+public:
+    typedef typename std::remove_extent<T>::type element_type;
+
+    weak_linked_ptr();
+
+    weak_linked_ptr(weak_linked_ptr<T> const& rhs);
+    weak_linked_ptr<T> const& operator=(weak_linked_ptr<T> const& rhs);
+
+    weak_linked_ptr(weak_linked_ptr<T>&& rhs) noexcept;
+    weak_linked_ptr<T> const& operator=(weak_linked_ptr<T>&& rhs) noexcept;
+
+    ~weak_linked_ptr();
+
+    template<class S> weak_linked_ptr(linked_ptr<S> const& rhs);
+    template<class S> weak_linked_ptr(weak_linked_ptr<S> const& rhs);
+    template<class S> weak_linked_ptr<T> const& operator=(linked_ptr<S> const& rhs);
+    template<class S> weak_linked_ptr<T> const& operator=(weak_linked_ptr<S> const& rhs);
+
+    void reset();
+
+    bool expired() const;
+        // care!! Complexity is linear of the count
+    long use_count() const;
+    linked_ptr<T> lock() const;
+
+    void swap(weak_linked_ptr<T>& rhs);
+
+    template<class S> bool owner_before(linked_ptr<S> const& rhs) const;
+    template<class S> bool owner_before(weak_linked_ptr<S> const& rhs) const;
+
+private:
+    element_type* mData{ nullptr };
+    mutable list_node mNode;
+    deleter_storage mDeleter;
+
+        // held is the pointer of the handle owning the deleter
+    template<class S, class N>
+    void observe(S* data, void const* held, N& node, deleter_storage const& deleter);
+    void* owned() const;
+
+    template<class S>
+    friend class weak_linked_ptr;
+    template<class S>
+    friend class linked_ptr;
+};
+
+
+    // plain view of a linked_ptr for passing it down a call chain:
+    // copying it doesn't touch the ring, share() joins the ring of
+    // the viewed pointer when the callee wants to keep the object.
+    // care!! Valid only while the viewed linked_ptr lives and stays
+    // where it is
+template<class T>
+class borrowed_linked_ptr
+{
+private:
+    typedef void (borrowed_linked_ptr<T>::*bool_type)() const;
+
+public:
+    typedef typename std::remove_extent<T>::type element_type;
+
+    borrowed_linked_ptr();
+    template<class S> borrowed_linked_ptr(linked_ptr<S> const& owner);
+    template<class S> borrowed_linked_ptr(borrowed_linked_ptr<S> const& rhs);
+
+        // new owner next to the viewed one
+    linked_ptr<T> share() const;
+
+    element_type* get() const;
+    element_type& operator*() const;
+    element_type* operator->() const;
+
+    operator bool_type() const;
+
+private:
+    element_type* mData{ nullptr };
+    list_node* mNode{ nullptr };
+    deleter_storage const* mDeleter{ nullptr };
+    void const* mHeld{ nullptr };
+
+    void bool_test_function() const;
+
+    template<class S>
+    friend class borrowed_linked_ptr;
+};
+
+
+    // base of objects that hand out owning pointers to themselves.
+    // linked_ptr's constructed from the raw pointer and make_linked
+    // leave the object a weak pointer to their ring: linked_from_this()
+    // joins that ring instead of starting a second one.
+    // It's empty while no linked_ptr owns the object
+template<class T>
+class enable_linked_from_this
+{
+public:
+    linked_ptr<T> linked_from_this();
+    linked_ptr<T const> linked_from_this() const;
+        // expired while no linked_ptr owns the object
+    weak_linked_ptr<T> weak_from_this();
+    weak_linked_ptr<T const> weak_from_this() const;
+
+protected:
+    enable_linked_from_this();
+        // a copy is a new object, its owners are yet to come
+    enable_linked_from_this(enable_linked_from_this<T> const& rhs);
+    enable_linked_from_this<T>& operator=(enable_linked_from_this<T> const& rhs);
+    ~enable_linked_from_this();
+
+private:
+    mutable weak_linked_ptr<T> mWeakThis;
+
+    template<class S>
+    friend class linked_ptr;
+};
+
+
+    // allocates the object together with its deleter in a single block.
+    // make_linked<T[]>(n) allocates n value-initialized elements the same way
 template<class T, class... Args>
 linked_ptr<T> make_linked(Args&&... args);
 
+    // same as make_linked, but the block is allocated and freed by alloc
+template<class T, class A, class... Args>
+linked_ptr<T> allocate_linked(A const& alloc, Args&&... args);
+
+
+    // resets every pointer of a contiguous range, meant for tearing down
+    // big containers: the ring neighbours of the pointers further in
+    // the range are prefetched, so the resets don't wait on each of them
+template<class T>
+void destroy_range(linked_ptr<T>* first, linked_ptr<T>* last);
+
+    // brings the ring neighbours of ptr into the cache, for code
+    // that is about to move or reset many pointers in a row
+template<class T>
+void prefetch_ring(linked_ptr<T> const& ptr);
+
+
+    // casts of the object pointer, the result joins the ring of r.
+    // The rvalue versions take the place of r instead, r is left empty.
+    // dynamic_linked_cast gives an empty pointer and leaves r alone
+    // when the cast fails, so do all of them when the result can't
+    // get its deleter
+template<class T, class S>
+linked_ptr<T> static_linked_cast(linked_ptr<S> const& r);
+template<class T, class S>
+linked_ptr<T> static_linked_cast(linked_ptr<S>&& r);
+template<class T, class S>
+linked_ptr<T> dynamic_linked_cast(linked_ptr<S> const& r);
+template<class T, class S>
+linked_ptr<T> dynamic_linked_cast(linked_ptr<S>&& r);
+template<class T, class S>
+linked_ptr<T> const_linked_cast(linked_ptr<S> const& r);
+template<class T, class S>
+linked_ptr<T> const_linked_cast(linked_ptr<S>&& r);
+template<class T, class S>
+linked_ptr<T> reinterpret_linked_cast(linked_ptr<S> const& r);
+template<class T, class S>
+linked_ptr<T> reinterpret_linked_cast(linked_ptr<S>&& r);
+
+    // comparisons of the pointed objects, with another linked_ptr,
+    // a raw pointer or nullptr: nothing joins any ring
+template<class T, class U>
+bool operator==(const linked_ptr<T>& left, const linked_ptr<U>& right);
+template<class T, class U>
+bool operator!=(const linked_ptr<T>& left, const linked_ptr<U>& right);
+template<class T, class U>
+bool operator<(const linked_ptr<T>& left, const linked_ptr<U>& right);
+
+template<class T, class U>
+bool operator==(const linked_ptr<T>& left, U const* right);
+template<class T, class U>
+bool operator==(U const* left, const linked_ptr<T>& right);
+template<class T, class U>
+bool operator!=(const linked_ptr<T>& left, U const* right);
+template<class T, class U>
+bool operator!=(U const* left, const linked_ptr<T>& right);
+template<class T, class U>
+bool operator<(const linked_ptr<T>& left, U const* right);
+template<class T, class U>
+bool operator<(U const* left, const linked_ptr<T>& right);
 
 template<class T>
-bool operator==(const linked_ptr<T>& left, const linked_ptr<T>& right);
+bool operator==(const linked_ptr<T>& left, std::nullptr_t);
+template<class T>
+bool operator==(std::nullptr_t, const linked_ptr<T>& right);
+template<class T>
+bool operator!=(const linked_ptr<T>& left, std::nullptr_t);
+template<class T>
+bool operator!=(std::nullptr_t, const linked_ptr<T>& right);
+
+    // transparent ordering for associative containers of linked_ptr's:
+    // find() and erase() take raw pointers, no temporary handle
+    // has to join the ring of the element
+struct linked_ptr_less
+{
+    typedef void is_transparent;
+
+    template<class L, class R>
+    bool operator()(L const& left, R const& right) const;
+};
+
+    // found by std algorithms, exchanges the places of the two nodes
+    // instead of moving through a temporary
 template<class T>
-bool operator!=(const linked_ptr<T>& left, const linked_ptr<T>& right);
+void swap(linked_ptr<T>& left, linked_ptr<T>& right);
 template<class T>
-bool operator<(const linked_ptr<T>& left, const linked_ptr<T>& right);
+void swap(weak_linked_ptr<T>& left, weak_linked_ptr<T>& right);
+
+namespace std
+{
+        // same hash as the raw pointer, so unordered containers
+        // can be searched with either
+    template<class T>
+    struct hash<linked_ptr<T>>
+    {
+        std::size_t operator()(linked_ptr<T> const& ptr) const;
+    };
+}
 
 #include "linked_ptr.hpp"
 
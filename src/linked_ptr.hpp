@@ -1,8 +1,23 @@
 #ifndef SMART_POINTERS_LINKED_PTR_CPP
 #define SMART_POINTERS_LINKED_PTR_CPP
 
+#include <cstddef>
+#include <cstdint>
+#include <functional> // for less
+#include <new>
+#include <type_traits>
 #include <utility> // for swap
 
+    // hint only, a no-op for the compilers without the builtin
+inline void prefetch_for_write(void const* address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 1);
+#else
+    (void)address;
+#endif
+}
+
 /*********************************************************/
 /*                      list_node                        */
 list_node::list_node()
@@ -14,345 +29,1463 @@ list_node::~list_node()
     unlink();
 }
 
-list_node::list_node(list_node& rhs)
+list_node::list_node(list_node& rhs)
+{
+    link(rhs);
+}
+
+list_node const& list_node::operator=(list_node& rhs)
+{
+    link(rhs);
+    return *this;
+}
+
+list_node::list_node(list_node&& rhs) noexcept
+{
+    take(rhs);
+}
+
+list_node const& list_node::operator=(list_node&& rhs) noexcept
+{
+    take(rhs);
+    return *this;
+}
+
+void list_node::link(list_node& rhs)
+{
+    if (this != &rhs)
+    {
+        unlink();
+        list_node* before = rhs.prev_node();
+        prev = reinterpret_cast<std::uintptr_t>(before);
+        next = &rhs;
+        if (before != nullptr)
+            before->next = this;
+        rhs.set_prev(this);
+    }
+}
+
+void list_node::link_weak(list_node& rhs)
+{
+    if (this != &rhs)
+    {
+        unlink();
+            // weak members stay behind the last owner
+        list_node* after = &rhs;
+        if (!rhs.weak())
+        {
+            while (after->next != nullptr && !after->next->weak())
+                after = after->next;
+        }
+        prev = reinterpret_cast<std::uintptr_t>(after) | WEAK_FLAG;
+        next = after->next;
+        if (next != nullptr)
+            next->set_prev(this);
+        after->next = this;
+    }
+}
+
+void list_node::take(list_node& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        unlink();
+        prev = rhs.prev;
+        next = rhs.next;
+        list_node* before = prev_node();
+        if (before != nullptr)
+            before->next = this;
+        if (next != nullptr)
+            next->set_prev(this);
+        rhs.prev = 0;
+        rhs.next = nullptr;
+    }
+}
+
+void list_node::unlink()
+{
+    list_node* before = prev_node();
+    if (!weak() && before == nullptr && next != nullptr && next->weak())
+    {
+            // the last owner leaves, weak members are left on their own
+        list_node* it{ next };
+        while (it != nullptr)
+        {
+            list_node* following = it->next;
+            it->prev = WEAK_FLAG;
+            it->next = nullptr;
+            it = following;
+        }
+    }
+    else
+    {
+        if (before != nullptr)
+            before->next = next;
+        if (next != nullptr)
+            next->set_prev(before);
+    }
+    prev = 0;
+    next = nullptr;
+}
+
+bool list_node::unique() const
+{
+    return (prev_node() == nullptr && (next == nullptr || next->weak()));
+}
+
+long list_node::use_count() const
+{
+    long count{ 1 };
+    list_node* it{ prev_node() };
+    while (it != nullptr)
+    {
+        it = it->prev_node();
+        ++count;
+    }
+    it = next;
+    while (it != nullptr && !it->weak())
+    {
+        it = it->next;
+        ++count;
+    }
+    return count;
+}
+
+bool list_node::alone_with(list_node const& rhs) const
+{
+    return (prev_node() == nullptr && next == &rhs && rhs.next == nullptr);
+}
+
+void list_node::swap(list_node& rhs)
+{
+    if (this == &rhs)
+        return;
+    if (rhs.next == this)
+    {
+        rhs.swap(*this);
+        return;
+    }
+        // nodes exchange their places, the weak flag belongs to the place
+    list_node* thisPrev{ prev_node() };
+    list_node* thisNext{ next };
+    list_node* rhsPrev{ rhs.prev_node() };
+    list_node* rhsNext{ rhs.next };
+    std::uintptr_t const thisFlag{ prev & WEAK_FLAG };
+    std::uintptr_t const rhsFlag{ rhs.prev & WEAK_FLAG };
+    if (thisNext == &rhs)
+    {
+            // rhs follows this one
+        rhs.prev = reinterpret_cast<std::uintptr_t>(thisPrev) | thisFlag;
+        rhs.next = this;
+        prev = reinterpret_cast<std::uintptr_t>(&rhs) | rhsFlag;
+        next = rhsNext;
+        if (thisPrev != nullptr)
+            thisPrev->next = &rhs;
+        if (rhsNext != nullptr)
+            rhsNext->set_prev(this);
+        return;
+    }
+    rhs.prev = reinterpret_cast<std::uintptr_t>(thisPrev) | thisFlag;
+    rhs.next = thisNext;
+    prev = reinterpret_cast<std::uintptr_t>(rhsPrev) | rhsFlag;
+    next = rhsNext;
+    if (thisPrev != nullptr)
+        thisPrev->next = &rhs;
+    if (thisNext != nullptr)
+        thisNext->set_prev(&rhs);
+    if (rhsPrev != nullptr)
+        rhsPrev->next = this;
+    if (rhsNext != nullptr)
+        rhsNext->set_prev(this);
+}
+
+bool list_node::weak() const
+{
+    return (prev & WEAK_FLAG) != 0;
+}
+
+bool list_node::expired() const
+{
+    return prev_node() == nullptr;
+}
+
+list_node* list_node::find_owner() const
+{
+    list_node* it{ prev_node() };
+    while (it != nullptr && it->weak())
+        it = it->prev_node();
+    return it;
+}
+
+list_node* list_node::prev_node() const
+{
+    return reinterpret_cast<list_node*>(prev & ~WEAK_FLAG);
+}
+
+list_node* list_node::next_node() const
+{
+    return next;
+}
+
+void list_node::set_prev(list_node* node)
+{
+    prev = reinterpret_cast<std::uintptr_t>(node) | (prev & WEAK_FLAG);
+}
+
+/*********************************************************/
+/*                      deleter                          */
+    // release of the objects of one stateless deleter type
+struct deleter_descriptor
+{
+    void (*destroy)(void* owned);
+};
+
+    // the deleter has no state, the first instance stands for all
+template<class S, class D>
+struct stateless_deleter
+{
+    static deleter_descriptor const* get(D const& deleter)
+    {
+        static bool const stored = (new (&sDeleter) D(deleter), true);
+        (void)stored;
+        return &sDescriptor;
+    }
+
+    static void destroy(void* owned)
+    {
+        (*reinterpret_cast<D*>(&sDeleter))(static_cast<S*>(owned));
+    }
+
+    static typename std::aligned_storage<sizeof(D), std::alignment_of<D>::value>::type sDeleter;
+    static deleter_descriptor const sDescriptor;
+};
+
+template<class S, class D>
+typename std::aligned_storage<sizeof(D), std::alignment_of<D>::value>::type stateless_deleter<S, D>::sDeleter;
+
+template<class S, class D>
+deleter_descriptor const stateless_deleter<S, D>::sDescriptor = { &stateless_deleter<S, D>::destroy };
+
+struct custom_deleter_base
+{
+    virtual ~custom_deleter_base() {}
+    virtual void destroy(void* ptr) const = 0;
+        // frees the deleter itself once no handle refers to it
+    virtual void deallocate()
+    {
+        delete this;
+    }
+
+    void* owned{ nullptr };
+        // owners and weak pointers referring to the block
+    long refs{ 1 };
+};
+
+template<class T, class D>
+struct custom_deleter : public custom_deleter_base
+{
+    custom_deleter(D deleter)
+        : mDeleter(deleter)
+    {
+    }
+
+    void destroy(void* ptr) const
+    {
+        mDeleter(static_cast<T*>(ptr));
+    }
+
+private:
+    D const mDeleter;
+};
+
+    // stateless deleter of a handle that doesn't point to the owned
+    // object, the block keeps the owned pointer for it
+struct alias_deleter : public custom_deleter_base
+{
+    alias_deleter(deleter_descriptor const* descriptor)
+        : mDescriptor(descriptor)
+    {
+    }
+
+    void destroy(void* ptr) const
+    {
+        mDescriptor->destroy(ptr);
+    }
+
+private:
+    deleter_descriptor const* const mDescriptor;
+};
+
+    // object constructed right after the deleter in the same allocation,
+    // destroy() ends the object's lifetime and deallocate() frees both
+template<class T>
+struct linked_block : public custom_deleter_base
+{
+    template<class... Args>
+    static linked_block<T>* create(Args&&... args)
+    {
+        return new linked_block<T>(std::forward<Args>(args)...);
+    }
+
+    template<class... Args>
+    linked_block(Args&&... args)
+    {
+        new (&mStorage) T(std::forward<Args>(args)...);
+    }
+
+    T* get() const
+    {
+        return reinterpret_cast<T*>(&mStorage);
+    }
+
+    void destroy(void*) const
+    {
+        get()->~T();
+    }
+
+private:
+    mutable typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type mStorage;
+};
+
+    // elements of make_linked<T[]> placed right after the block header,
+    // there is no separate allocation for the array
+template<class T>
+struct linked_array_block : public custom_deleter_base
+{
+    static linked_array_block<T>* create(std::size_t size)
+    {
+        void* memory = ::operator new(offset() + size * sizeof(T));
+        linked_array_block<T>* block = new (memory) linked_array_block<T>();
+        T* first = block->get();
+        try
+        {
+            for (; block->mSize < size; ++block->mSize)
+                new (first + block->mSize) T();
+        }
+        catch (...)
+        {
+            block->destroy(nullptr);
+            block->deallocate();
+            throw;
+        }
+        return block;
+    }
+
+    T* get() const
+    {
+        char* memory = reinterpret_cast<char*>(const_cast<linked_array_block<T>*>(this));
+        return reinterpret_cast<T*>(memory + offset());
+    }
+
+    void destroy(void*) const
+    {
+        T* first = get();
+        for (std::size_t i = mSize; i > 0; --i)
+            first[i - 1].~T();
+    }
+
+    void deallocate()
+    {
+        this->~linked_array_block<T>();
+        ::operator delete(this);
+    }
+
+private:
+    static_assert(std::alignment_of<T>::value <= std::alignment_of<std::max_align_t>::value,
+        "over-aligned array elements");
+
+        // header size rounded up to the alignment of the elements
+    static constexpr std::size_t offset()
+    {
+        return (sizeof(linked_array_block<T>) + std::alignment_of<T>::value - 1)
+            / std::alignment_of<T>::value * std::alignment_of<T>::value;
+    }
+
+    std::size_t mSize{ 0 };
+};
+
+template<class T>
+struct linked_block_of
+{
+    typedef linked_block<T> type;
+};
+
+template<class T>
+struct linked_block_of<T[]>
+{
+    typedef linked_array_block<T> type;
+};
+
+    // same as linked_block, but the block comes from the allocator
+    // and is given back to it when the last owner is gone
+template<class T, class A>
+struct allocated_block : public custom_deleter_base
+{
+    typedef typename std::allocator_traits<A>::template rebind_alloc<allocated_block<T, A>> block_allocator;
+    typedef typename std::allocator_traits<A>::template rebind_alloc<T> object_allocator;
+    typedef std::allocator_traits<block_allocator> block_traits;
+    typedef std::allocator_traits<object_allocator> object_traits;
+
+    template<class... Args>
+    static allocated_block<T, A>* create(A const& alloc, Args&&... args)
+    {
+        block_allocator blockAlloc(alloc);
+        allocated_block<T, A>* block = block_traits::allocate(blockAlloc, 1);
+        new (block) allocated_block<T, A>(blockAlloc);
+        try
+        {
+            object_allocator objectAlloc(alloc);
+            object_traits::construct(objectAlloc, block->get(), std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            block->~allocated_block<T, A>();
+            block_traits::deallocate(blockAlloc, block, 1);
+            throw;
+        }
+        return block;
+    }
+
+    T* get() const
+    {
+        return reinterpret_cast<T*>(&mStorage);
+    }
+
+    void destroy(void*) const
+    {
+        object_allocator objectAlloc(mAlloc);
+        object_traits::destroy(objectAlloc, get());
+    }
+
+    void deallocate()
+    {
+        block_allocator blockAlloc(mAlloc);
+        this->~allocated_block<T, A>();
+        block_traits::deallocate(blockAlloc, this, 1);
+    }
+
+private:
+    allocated_block(block_allocator const& alloc)
+        : mAlloc(alloc)
+    {
+    }
+
+    block_allocator mAlloc;
+    mutable typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type mStorage;
+};
+
+/*********************************************************/
+/*                   deleter_storage                     */
+inline deleter_storage::deleter_storage()
+{
+}
+
+inline deleter_storage::deleter_storage(deleter_storage const& rhs)
+    : mValue(rhs.mValue)
+{
+    if (custom_deleter_base* shared = block())
+        ++shared->refs;
+}
+
+inline deleter_storage const& deleter_storage::operator=(deleter_storage const& rhs)
+{
+    if (this != &rhs)
+    {
+        deleter_storage copy(rhs);
+        std::swap(mValue, copy.mValue);
+    }
+    return *this;
+}
+
+inline deleter_storage::deleter_storage(deleter_storage&& rhs) noexcept
+    : mValue(rhs.mValue)
+{
+    rhs.mValue = 0;
+}
+
+inline deleter_storage const& deleter_storage::operator=(deleter_storage&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        release();
+        mValue = rhs.mValue;
+        rhs.mValue = 0;
+    }
+    return *this;
+}
+
+inline deleter_storage::~deleter_storage()
+{
+    release();
+}
+
+template<class S>
+deleter_storage::deleter_storage(S* data, void const* held)
+{
+    if (data != nullptr)
+        attach(stateless_deleter<S, std::default_delete<S>>::get(std::default_delete<S>()), data, held);
+}
+
+template<class S, class D>
+deleter_storage::deleter_storage(S* data, D deleter, void const* held)
+{
+    store(data, deleter, held, is_stateless<D>());
+}
+
+template<class S>
+deleter_storage deleter_storage::for_array(S* data, void const* held)
+{
+    deleter_storage storage;
+    if (data != nullptr)
+        storage.attach(stateless_deleter<S, std::default_delete<S[]>>::get(std::default_delete<S[]>()), data, held);
+    return storage;
+}
+
+inline deleter_storage deleter_storage::from_block(void const* owned, custom_deleter_base* block)
+{
+    deleter_storage storage;
+    storage.attach(block, owned);
+    return storage;
+}
+
+inline deleter_storage deleter_storage::rebind(void const* held, void const* alias) const
+{
+    if (mValue == 0 || block() != nullptr || held == alias)
+        return *this;
+    deleter_storage storage;
+    storage.attach(new alias_deleter(descriptor()), held);
+    return storage;
+}
+
+inline void deleter_storage::destroy(void const* held) const
+{
+    if (custom_deleter_base* shared = block())
+        shared->destroy(shared->owned);
+    else if (mValue != 0)
+        descriptor()->destroy(const_cast<void*>(held));
+}
+
+inline void* deleter_storage::owned(void const* held) const
+{
+    if (custom_deleter_base* shared = block())
+        return shared->owned;
+    return mValue != 0 ? const_cast<void*>(held) : nullptr;
+}
+
+template<class S, class D>
+void deleter_storage::store(S* data, D deleter, void const* held, std::true_type)
+{
+    attach(stateless_deleter<S, D>::get(deleter), data, held);
+}
+
+template<class S, class D>
+void deleter_storage::store(S* data, D deleter, void const*, std::false_type)
+{
+    custom_deleter_base* shared = nullptr;
+    try
+    {
+        shared = new custom_deleter<S, D>(deleter);
+    }
+    catch (...)
+    {
+        deleter(data);
+        throw;
+    }
+    attach(shared, data);
+}
+
+inline void deleter_storage::attach(deleter_descriptor const* descriptor, void const* owned, void const* held)
+{
+    if (owned == held)
+    {
+        mValue = reinterpret_cast<std::uintptr_t>(descriptor);
+        return;
+    }
+    custom_deleter_base* shared = nullptr;
+    try
+    {
+        shared = new alias_deleter(descriptor);
+    }
+    catch (...)
+    {
+        descriptor->destroy(const_cast<void*>(owned));
+        throw;
+    }
+    attach(shared, owned);
+}
+
+inline void deleter_storage::attach(custom_deleter_base* block, void const* owned)
+{
+    block->owned = const_cast<void*>(owned);
+    mValue = reinterpret_cast<std::uintptr_t>(block) | BLOCK_FLAG;
+}
+
+inline void deleter_storage::release()
+{
+    custom_deleter_base* shared = block();
+    mValue = 0;
+    if (shared != nullptr && --shared->refs == 0)
+        shared->deallocate();
+}
+
+inline deleter_descriptor const* deleter_storage::descriptor() const
+{
+    return reinterpret_cast<deleter_descriptor const*>(mValue);
+}
+
+inline custom_deleter_base* deleter_storage::block() const
+{
+    if ((mValue & BLOCK_FLAG) == 0)
+        return nullptr;
+    return reinterpret_cast<custom_deleter_base*>(mValue & ~BLOCK_FLAG);
+}
+
+/*********************************************************/
+/*                     linked_ptr                        */
+
+template<class T>
+linked_ptr<T>::linked_ptr()
+{
+}
+
+template<class T>
+linked_ptr<T>::linked_ptr(linked_ptr<T> const& rhs)
+    : mData(rhs.mData)
+    , mNode(rhs.mNode)
+    , mDeleter(rhs.mDeleter)
+{
+}
+
+template<class T>
+linked_ptr<T> const& linked_ptr<T>::operator=(linked_ptr<T> const& rhs)
+{
+    if (!same_view(rhs))
+    {
+        this_type(rhs).swap(*this);
+    }
+    return *this;
+}
+
+template<class T>
+linked_ptr<T>::linked_ptr(linked_ptr<T>&& rhs) noexcept
+    : mData(rhs.mData)
+    , mNode(std::move(rhs.mNode))
+    , mDeleter(std::move(rhs.mDeleter))
+{
+    rhs.mData = nullptr;
+}
+
+template<class T>
+linked_ptr<T> const& linked_ptr<T>::operator=(linked_ptr<T>&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+            // rhs may live inside the object released here,
+            // it's taken out before the old value goes
+        this_type(std::move(rhs)).swap(*this);
+    }
+    return *this;
+}
+
+template<class T>
+linked_ptr<T>::~linked_ptr()
+{
+    reset();
+}
+
+template<class T>
+template<class S, class>
+linked_ptr<T>::linked_ptr(S* data)
+    : mData(data)
+    , mDeleter(default_deleter(data, mData))
+{
+    share_this(data);
+}
+
+template<class T>
+template<class S>
+linked_ptr<T>::linked_ptr(linked_ptr<S> const& rhs)
+    : mData(rhs.mData)
+    , mNode(rhs.mNode)
+    , mDeleter(rhs.mDeleter.rebind(rhs.mData, mData))
+{
+}
+
+template<class T>
+template<class S>
+linked_ptr<T> const& linked_ptr<T>::operator=(linked_ptr<S> const& rhs)
+{
+    if (!same_view(rhs))
+    {
+        this_type(rhs).swap(*this);
+    }
+    return *this;
+}
+
+template<class T>
+template<class S>
+linked_ptr<T>::linked_ptr(linked_ptr<S>&& rhs)
+    : mData(rhs.mData)
+    , mDeleter(rhs.mDeleter.rebind(rhs.mData, mData))
+{
+    mNode.take(rhs.mNode);
+    rhs.mData = nullptr;
+    rhs.mDeleter = deleter_storage();
+}
+
+template<class T>
+template<class S>
+linked_ptr<T>::linked_ptr(linked_ptr<S> const& owner, element_type* data)
+    : mData(data)
+    , mNode(owner.mNode)
+    , mDeleter(owner.mDeleter.rebind(owner.mData, data))
+{
+}
+
+template<class T>
+template<class S>
+linked_ptr<T>::linked_ptr(linked_ptr<S>&& owner, element_type* data)
+    : mData(data)
+    , mDeleter(owner.mDeleter.rebind(owner.mData, data))
+{
+    mNode.take(owner.mNode);
+    owner.mData = nullptr;
+    owner.mDeleter = deleter_storage();
+}
+
+template<class T>
+template<class S, class D, class>
+linked_ptr<T>::linked_ptr(S* data, D deleter)
+    : mData(data)
+    , mDeleter(data, deleter, mData)
+{
+    share_this(data);
+}
+
+template<class T>
+template<class S>
+linked_ptr<T>::linked_ptr(std::auto_ptr<S>&& rhs)
+    : mData(rhs.get())
+    , mDeleter(rhs.get(), mData)
+{
+    share_this(rhs.release());
+}
+
+template<class T>
+template<class S, class D>
+linked_ptr<T>::linked_ptr(std::unique_ptr<S, D>&& rhs)
+    : mData(rhs.get())
+    , mDeleter(rhs.get(), rhs.get_deleter(), mData)
+{
+    share_this(rhs.release());
+}
+
+template<class T>
+template<class S>
+linked_ptr<T> const& linked_ptr<T>::operator=(std::auto_ptr<S>&& rhs)
+{
+    this_type(std::move(rhs)).swap(*this);
+    return *this;
+}
+
+template<class T>
+template<class S, class D>
+linked_ptr<T>const& linked_ptr<T>::operator=(std::unique_ptr<S, D>&& rhs)
+{
+    this_type(std::move(rhs)).swap(*this);
+    return *this;
+}
+
+template<class T>
+void linked_ptr<T>::reset()
+{
+    bool const last = mNode.unique();
+    mNode.unlink();
+    if (last)
+        mDeleter.destroy(mData);
+    mData = nullptr;
+    mDeleter = deleter_storage();
+}
+
+template<class T>
+void linked_ptr<T>::reset(element_type* data)
+{
+    reset();
+    mData = data;
+    mDeleter = default_deleter(data, mData);
+    share_this(data);
+}
+
+template<class T>
+template<class D>
+void linked_ptr<T>::reset(element_type* data, D d)
+{
+    reset();
+    mData = data;
+    mDeleter = deleter_storage(data, d, mData);
+    share_this(data);
+}
+
+template<class T>
+typename linked_ptr<T>::element_type* linked_ptr<T>::get()
+{
+    return mData;
+}
+
+template<class T>
+typename linked_ptr<T>::element_type const* linked_ptr<T>::get() const
+{
+    return mData;
+}
+
+template<class T>
+bool linked_ptr<T>::unique() const
+{
+    return mNode.unique();
+}
+
+template<class T>
+long linked_ptr<T>::use_count() const
+{
+    if (!mData)
+        return 0;
+    return mNode.use_count();
+}
+
+template<class T>
+typename linked_ptr<T>::element_type& linked_ptr<T>::operator*()
+{
+    return *mData;
+}
+
+template<class T>
+typename linked_ptr<T>::element_type const& linked_ptr<T>::operator*() const
+{
+    return *mData;
+}
+
+template<class T>
+template<class U>
+typename std::enable_if<!std::is_array<U>::value, typename linked_ptr<T>::element_type*>::type linked_ptr<T>::operator->()
+{
+    return mData;
+}
+
+template<class T>
+template<class U>
+typename std::enable_if<!std::is_array<U>::value, typename linked_ptr<T>::element_type const*>::type linked_ptr<T>::operator->() const
+{
+    return mData;
+}
+
+template<class T>
+template<class U>
+typename std::enable_if<std::is_array<U>::value, typename linked_ptr<T>::element_type&>::type linked_ptr<T>::operator[](std::size_t index)
+{
+    return mData[index];
+}
+
+template<class T>
+template<class U>
+typename std::enable_if<std::is_array<U>::value, typename linked_ptr<T>::element_type const&>::type linked_ptr<T>::operator[](std::size_t index) const
+{
+    return mData[index];
+}
+
+template<class T>
+void linked_ptr<T>::swap(linked_ptr<T>& rhs)
+{
+    if (!same_view(rhs))
+    {
+        std::swap(mData, rhs.mData);
+        mNode.swap(rhs.mNode);
+        std::swap(mDeleter, rhs.mDeleter);
+    }
+}
+
+template<class T>
+template<class S>
+deleter_storage linked_ptr<T>::default_deleter(S* data, void const* held)
+{
+    return std::is_array<T>::value ? deleter_storage::for_array(data, held) : deleter_storage(data, held);
+}
+
+template<class T>
+void* linked_ptr<T>::owned() const
+{
+    return mDeleter.owned(mData);
+}
+
+template<class T>
+template<class U>
+void linked_ptr<T>::share_this(enable_linked_from_this<U> const* base)
+{
+    if (base != nullptr && base->mWeakThis.expired())
+    {
+        base->mWeakThis.reset();
+        try
+        {
+            base->mWeakThis.observe(const_cast<U*>(static_cast<U const*>(base)), mData, mNode, mDeleter);
+        }
+        catch (...)
+        {
+            reset();
+            throw;
+        }
+    }
+}
+
+template<class T>
+void linked_ptr<T>::share_this(void const volatile*)
+{
+}
+
+template<class T>
+template<class S>
+bool linked_ptr<T>::owner_before(linked_ptr<S> const& rhs) const
+{
+    return std::less<void*>()(owned(), rhs.owned());
+}
+
+template<class T>
+template<class S>
+bool linked_ptr<T>::owner_before(weak_linked_ptr<S> const& rhs) const
+{
+    return std::less<void*>()(owned(), rhs.owned());
+}
+
+template<class T>
+template<class S>
+bool linked_ptr<T>::same_view(linked_ptr<S> const& rhs) const
+{
+    return mData == rhs.mData && owned() == rhs.owned();
+}
+
+template<class T>
+void linked_ptr<T>::bool_test_function() const
+{
+}
+
+template<class T>
+linked_ptr<T>::operator bool_type() const
+{
+    return mData != nullptr ? &linked_ptr<T>::bool_test_function : nullptr;
+}
+
+/*********************************************************/
+/*                   weak_linked_ptr                     */
+
+template<class T>
+weak_linked_ptr<T>::weak_linked_ptr()
+{
+}
+
+template<class T>
+weak_linked_ptr<T>::weak_linked_ptr(weak_linked_ptr<T> const& rhs)
+{
+    observe(rhs.mData, rhs.mData, rhs.mNode, rhs.mDeleter);
+}
+
+template<class T>
+weak_linked_ptr<T> const& weak_linked_ptr<T>::operator=(weak_linked_ptr<T> const& rhs)
 {
-    link(rhs);
+    if (this != &rhs)
+    {
+        reset();
+        observe(rhs.mData, rhs.mData, rhs.mNode, rhs.mDeleter);
+    }
+    return *this;
 }
 
-list_node const& list_node::operator=(list_node& rhs)
+template<class T>
+weak_linked_ptr<T>::weak_linked_ptr(weak_linked_ptr<T>&& rhs) noexcept
+    : mData(rhs.mData)
+    , mNode(std::move(rhs.mNode))
+    , mDeleter(std::move(rhs.mDeleter))
 {
-    link(rhs);
-    return *this;
+    rhs.mData = nullptr;
 }
 
-void list_node::link(list_node& rhs)
+template<class T>
+weak_linked_ptr<T> const& weak_linked_ptr<T>::operator=(weak_linked_ptr<T>&& rhs) noexcept
 {
     if (this != &rhs)
     {
-        unlink();
-        prev = rhs.prev;
-        next = &rhs;
-        if (prev != nullptr)
-            prev->next = this;
-        rhs.prev = this;
+        mData = rhs.mData;
+        mNode = std::move(rhs.mNode);
+        mDeleter = std::move(rhs.mDeleter);
+        rhs.mData = nullptr;
     }
+    return *this;
 }
 
-void list_node::unlink()
+template<class T>
+weak_linked_ptr<T>::~weak_linked_ptr()
 {
-    if (prev != nullptr)
-        prev->next = next;
-    if (next != nullptr)
-        next->prev = prev;
-    prev = nullptr;
-    next = nullptr;
 }
 
-bool list_node::unique() const
+template<class T>
+template<class S>
+weak_linked_ptr<T>::weak_linked_ptr(linked_ptr<S> const& rhs)
 {
-    return (prev == nullptr && next == nullptr);
+    observe(rhs.mData, rhs.mData, rhs.mNode, rhs.mDeleter);
 }
 
-long list_node::use_count() const
+template<class T>
+template<class S>
+weak_linked_ptr<T>::weak_linked_ptr(weak_linked_ptr<S> const& rhs)
 {
-    long count{ 1 };
-    list_node* it{ prev };
-    while (it != nullptr)
-    {
-        it = it->prev;
-        ++count;
-    }
-    it = next;
-    while (it != nullptr)
-    {
-        it = it->next;
-        ++count;
-    }
-    return count;
+    observe(rhs.mData, rhs.mData, rhs.mNode, rhs.mDeleter);
 }
 
-void list_node::swap(list_node& rhs)
+template<class T>
+template<class S>
+weak_linked_ptr<T> const& weak_linked_ptr<T>::operator=(linked_ptr<S> const& rhs)
 {
-    if (this == &rhs)
-        return;
-    list_node thisCopy(*this);
-    list_node rhsCopy(rhs);
-    rhs = thisCopy;
-    *this = rhsCopy;
+    reset();
+    observe(rhs.mData, rhs.mData, rhs.mNode, rhs.mDeleter);
+    return *this;
 }
 
-/*********************************************************/
-/*                      deleter                          */
-struct custom_deleter_base
+template<class T>
+template<class S>
+weak_linked_ptr<T> const& weak_linked_ptr<T>::operator=(weak_linked_ptr<S> const& rhs)
 {
-    virtual ~custom_deleter_base() {}
-    virtual void destroy(void* ptr) const = 0;
-};
+    reset();
+    observe(rhs.mData, rhs.mData, rhs.mNode, rhs.mDeleter);
+    return *this;
+}
 
-template<class T, class D>
-struct custom_deleter : public custom_deleter_base
+template<class T>
+template<class S, class N>
+void weak_linked_ptr<T>::observe(S* data, void const* held, N& node, deleter_storage const& deleter)
 {
-    custom_deleter(D deleter)
-        : mDeleter(deleter)
-    {
-    }
-
-    void destroy(void* ptr) const
-    {
-        mDeleter(static_cast<T*>(ptr));
-    }
+        // nothing to observe: an empty pointer, or a weak one
+        // whose owners are all gone
+    if (data == nullptr || (node.weak() && node.find_owner() == nullptr))
+        return;
+    element_type* const view = data;
+    mDeleter = deleter.rebind(held, view);
+    mData = view;
+    mNode.link_weak(node);
+}
 
-private:
-    D const mDeleter;
-};
+template<class T>
+void* weak_linked_ptr<T>::owned() const
+{
+    return mDeleter.owned(mData);
+}
 
-/*********************************************************/
-/*                     linked_ptr                        */
+template<class T>
+void weak_linked_ptr<T>::reset()
+{
+    mNode.unlink();
+    mData = nullptr;
+    mDeleter = deleter_storage();
+}
 
 template<class T>
-linked_ptr<T>::linked_ptr()
+bool weak_linked_ptr<T>::expired() const
 {
+    return mNode.expired();
 }
 
 template<class T>
-linked_ptr<T>::linked_ptr(linked_ptr<T> const& rhs)
-    : mData(rhs.mData)
-    , mNode(rhs.mNode)
-    , mDeleter(rhs.mDeleter)
+long weak_linked_ptr<T>::use_count() const
 {
+    list_node* owner = mNode.find_owner();
+    if (owner == nullptr)
+        return 0;
+    return owner->use_count();
 }
 
 template<class T>
-linked_ptr<T> const& linked_ptr<T>::operator=(linked_ptr<T> const& rhs)
+linked_ptr<T> weak_linked_ptr<T>::lock() const
 {
-    if (mData != rhs.mData)
+    linked_ptr<T> ptr;
+    list_node* owner = mNode.find_owner();
+    if (owner != nullptr)
     {
-        this_type(rhs).swap(*this);
+        ptr.mData = mData;
+        ptr.mNode.link(*owner);
+        ptr.mDeleter = mDeleter;
     }
-    return *this;
+    return ptr;
 }
 
 template<class T>
-linked_ptr<T>::linked_ptr(linked_ptr<T>&& rhs)
-    : mData(rhs.mData)
-    , mNode(rhs.mNode)
-    , mDeleter(rhs.mDeleter)
+template<class S>
+bool weak_linked_ptr<T>::owner_before(linked_ptr<S> const& rhs) const
 {
-    rhs.reset();
+    return std::less<void*>()(owned(), rhs.owned());
 }
 
 template<class T>
-linked_ptr<T> const& linked_ptr<T>::operator=(linked_ptr<T>&& rhs)
+template<class S>
+bool weak_linked_ptr<T>::owner_before(weak_linked_ptr<S> const& rhs) const
+{
+    return std::less<void*>()(owned(), rhs.owned());
+}
+
+template<class T>
+void weak_linked_ptr<T>::swap(weak_linked_ptr<T>& rhs)
 {
-    if (mData != rhs.mData)
+    if (this != &rhs)
     {
-        this_type(std::move(rhs)).swap(*this);
+        std::swap(mData, rhs.mData);
+        mNode.swap(rhs.mNode);
+        std::swap(mDeleter, rhs.mDeleter);
     }
-    return *this;
 }
 
+/*********************************************************/
+/*                 borrowed_linked_ptr                   */
+
 template<class T>
-linked_ptr<T>::~linked_ptr()
+borrowed_linked_ptr<T>::borrowed_linked_ptr()
 {
-    reset();
 }
 
 template<class T>
 template<class S>
-linked_ptr<T>::linked_ptr(S* data)
-    : mData(data)
+borrowed_linked_ptr<T>::borrowed_linked_ptr(linked_ptr<S> const& owner)
+    : mData(owner.mData)
+    , mNode(owner.mData != nullptr ? &owner.mNode : nullptr)
+    , mDeleter(&owner.mDeleter)
+    , mHeld(owner.mData)
 {
 }
 
 template<class T>
 template<class S>
-linked_ptr<T>::linked_ptr(linked_ptr<S> const& rhs)
+borrowed_linked_ptr<T>::borrowed_linked_ptr(borrowed_linked_ptr<S> const& rhs)
     : mData(rhs.mData)
     , mNode(rhs.mNode)
     , mDeleter(rhs.mDeleter)
+    , mHeld(rhs.mHeld)
 {
 }
 
 template<class T>
-template<class S>
-linked_ptr<T> const& linked_ptr<T>::operator=(linked_ptr<S> const& rhs)
+linked_ptr<T> borrowed_linked_ptr<T>::share() const
 {
-    if (mData != rhs.mData)
+    linked_ptr<T> ptr;
+    if (mNode != nullptr)
     {
-        this_type(rhs).swap(*this);
+        ptr.mDeleter = mDeleter->rebind(mHeld, mData);
+        ptr.mData = mData;
+        ptr.mNode.link(*mNode);
     }
-    return *this;
+    return ptr;
 }
 
 template<class T>
-template<class S, class D>
-linked_ptr<T>::linked_ptr(S* data, D deleter)
-    : mData(data)
-    , mDeleter(new custom_deleter<T, D>(deleter))
+typename borrowed_linked_ptr<T>::element_type* borrowed_linked_ptr<T>::get() const
 {
+    return mData;
 }
 
 template<class T>
-template<class S>
-linked_ptr<T>::linked_ptr(std::auto_ptr<S>&& rhs)
-    : mData(rhs.release())
+typename borrowed_linked_ptr<T>::element_type& borrowed_linked_ptr<T>::operator*() const
 {
+    return *mData;
 }
 
 template<class T>
-template<class S, class D>
-linked_ptr<T>::linked_ptr(std::unique_ptr<S, D>&& rhs)
-    : mData(rhs.release())
-    , mDeleter(new custom_deleter<T, D>(rhs.get_deleter()))
+typename borrowed_linked_ptr<T>::element_type* borrowed_linked_ptr<T>::operator->() const
 {
+    return mData;
 }
 
 template<class T>
-template<class S>
-linked_ptr<T> const& linked_ptr<T>::operator=(std::auto_ptr<S>&& rhs)
+void borrowed_linked_ptr<T>::bool_test_function() const
 {
-    this_type(std::move(rhs)).swap(*this);
-    return *this;
 }
 
 template<class T>
-template<class S, class D>
-linked_ptr<T>const& linked_ptr<T>::operator=(std::unique_ptr<S, D>&& rhs)
+borrowed_linked_ptr<T>::operator bool_type() const
 {
-    this_type(std::move(rhs)).swap(*this);
-    return *this;
+    return mData != nullptr ? &borrowed_linked_ptr<T>::bool_test_function : nullptr;
 }
 
+/*********************************************************/
+/*                enable_linked_from_this                */
+
 template<class T>
-void linked_ptr<T>::reset()
+enable_linked_from_this<T>::enable_linked_from_this()
 {
-    if (mNode.unique())
-    {
-        if (mDeleter)
-        {
-            mDeleter->destroy(static_cast<void*>(mData));
-            delete mDeleter;
-        }
-        else
-            delete mData;
-    }
-    else
-        mNode.unlink();
-    mData = nullptr;
-    mDeleter = nullptr;
 }
 
 template<class T>
-void linked_ptr<T>::reset(T* data)
+enable_linked_from_this<T>::enable_linked_from_this(enable_linked_from_this<T> const&)
 {
-    reset();
-    mData = data;
 }
 
 template<class T>
-template<class D>
-void linked_ptr<T>::reset(T* data, D d)
+enable_linked_from_this<T>& enable_linked_from_this<T>::operator=(enable_linked_from_this<T> const&)
 {
-    reset(data);
-    mDeleter = new custom_deleter<D>(d);
+    return *this;
 }
 
 template<class T>
-T* linked_ptr<T>::get()
+enable_linked_from_this<T>::~enable_linked_from_this()
 {
-    return mData;
 }
 
 template<class T>
-T const* linked_ptr<T>::get() const
+linked_ptr<T> enable_linked_from_this<T>::linked_from_this()
 {
-    return mData;
+    return mWeakThis.lock();
 }
 
 template<class T>
-bool linked_ptr<T>::unique() const
+linked_ptr<T const> enable_linked_from_this<T>::linked_from_this() const
 {
-    return mNode.unique();
+    return mWeakThis.lock();
 }
 
 template<class T>
-long linked_ptr<T>::use_count() const
+weak_linked_ptr<T> enable_linked_from_this<T>::weak_from_this()
 {
-    if (!mData)
-        return 0;
-    return mNode.use_count();
+    return mWeakThis;
 }
 
 template<class T>
-T& linked_ptr<T>::operator*()
+weak_linked_ptr<T const> enable_linked_from_this<T>::weak_from_this() const
 {
-    return *mData;
+    return mWeakThis;
 }
 
-template<class T>
-T const& linked_ptr<T>::operator*() const
+
+template<class T, class... Args>
+linked_ptr<T> make_linked(Args&&... args)
 {
-    return *mData;
+    typedef typename linked_block_of<T>::type block_type;
+    block_type* block = block_type::create(std::forward<Args>(args)...);
+    linked_ptr<T> ptr;
+    ptr.mData = block->get();
+    ptr.mDeleter = deleter_storage::from_block(block->get(), block);
+    ptr.share_this(ptr.mData);
+    return ptr;
 }
 
-template<class T>
-T* linked_ptr<T>::operator->()
+template<class T, class A, class... Args>
+linked_ptr<T> allocate_linked(A const& alloc, Args&&... args)
 {
-    return mData;
+    allocated_block<T, A>* block = allocated_block<T, A>::create(alloc, std::forward<Args>(args)...);
+    linked_ptr<T> ptr;
+    ptr.mData = block->get();
+    ptr.mDeleter = deleter_storage::from_block(block->get(), block);
+    ptr.share_this(ptr.mData);
+    return ptr;
 }
 
+
 template<class T>
-void linked_ptr<T>::swap(linked_ptr<T>& rhs)
+void destroy_range(linked_ptr<T>* first, linked_ptr<T>* last)
 {
-    if (mData != rhs.mData)
+        // ring neighbours of the pointers a bit further in the range
+        // are fetched while the current ones are reset, the range itself
+        // is walked in order
+    std::ptrdiff_t const AHEAD = 16;
+    for (linked_ptr<T>* it = first; it != last; ++it)
     {
-        std::swap(mData, rhs.mData);
-        mNode.swap(rhs.mNode);
-        std::swap(mDeleter, rhs.mDeleter);
+        if (last - it > AHEAD)
+        {
+            linked_ptr<T> const& ahead = it[AHEAD];
+            prefetch_ring(ahead);
+            prefetch_for_write(ahead.mData);
+        }
+        it->reset();
     }
 }
 
 template<class T>
-T const* linked_ptr<T>::operator->() const
+void prefetch_ring(linked_ptr<T> const& ptr)
 {
-    return mData;
+    prefetch_for_write(ptr.mNode.prev_node());
+    prefetch_for_write(ptr.mNode.next_node());
+}
+
+
+    // the object pointer as the owner holds it, constness of
+    // the handle doesn't carry over to the object
+template<class S>
+typename linked_ptr<S>::element_type* source_pointer(linked_ptr<S> const& r)
+{
+    return const_cast<typename linked_ptr<S>::element_type*>(r.get());
+}
+
+template<class T, class S>
+linked_ptr<T> static_linked_cast(linked_ptr<S> const& r)
+{
+    return linked_ptr<T>(r, static_cast<typename linked_ptr<T>::element_type*>(source_pointer(r)));
+}
+
+template<class T, class S>
+linked_ptr<T> static_linked_cast(linked_ptr<S>&& r)
+{
+    typename linked_ptr<T>::element_type* data = static_cast<typename linked_ptr<T>::element_type*>(source_pointer(r));
+    return linked_ptr<T>(std::move(r), data);
+}
+
+template<class T, class S>
+linked_ptr<T> dynamic_linked_cast(linked_ptr<S> const& r)
+{
+    typename linked_ptr<T>::element_type* data = dynamic_cast<typename linked_ptr<T>::element_type*>(source_pointer(r));
+    if (data == nullptr)
+        return linked_ptr<T>();
+    return linked_ptr<T>(r, data);
+}
+
+template<class T, class S>
+linked_ptr<T> dynamic_linked_cast(linked_ptr<S>&& r)
+{
+    typename linked_ptr<T>::element_type* data = dynamic_cast<typename linked_ptr<T>::element_type*>(source_pointer(r));
+    if (data == nullptr)
+        return linked_ptr<T>();
+    return linked_ptr<T>(std::move(r), data);
+}
+
+template<class T, class S>
+linked_ptr<T> const_linked_cast(linked_ptr<S> const& r)
+{
+    return linked_ptr<T>(r, const_cast<typename linked_ptr<T>::element_type*>(source_pointer(r)));
+}
+
+template<class T, class S>
+linked_ptr<T> const_linked_cast(linked_ptr<S>&& r)
+{
+    typename linked_ptr<T>::element_type* data = const_cast<typename linked_ptr<T>::element_type*>(source_pointer(r));
+    return linked_ptr<T>(std::move(r), data);
+}
+
+template<class T, class S>
+linked_ptr<T> reinterpret_linked_cast(linked_ptr<S> const& r)
+{
+    return linked_ptr<T>(r, reinterpret_cast<typename linked_ptr<T>::element_type*>(source_pointer(r)));
+}
+
+template<class T, class S>
+linked_ptr<T> reinterpret_linked_cast(linked_ptr<S>&& r)
+{
+    typename linked_ptr<T>::element_type* data = reinterpret_cast<typename linked_ptr<T>::element_type*>(source_pointer(r));
+    return linked_ptr<T>(std::move(r), data);
+}
+
+template<class T, class U>
+bool operator==(linked_ptr<T> const& left, linked_ptr<U> const& right)
+{
+    return left.get() == right.get();
+}
+
+template<class T, class U>
+bool operator!=(linked_ptr<T> const& left, linked_ptr<U> const& right)
+{
+    return !(left == right);
+}
+
+template<class T, class U>
+bool operator<(linked_ptr<T> const& left, linked_ptr<U> const& right)
+{
+    return left.get() < right.get();
+}
+
+template<class T, class U>
+bool operator==(linked_ptr<T> const& left, U const* right)
+{
+    return left.get() == right;
+}
+
+template<class T, class U>
+bool operator==(U const* left, linked_ptr<T> const& right)
+{
+    return left == right.get();
+}
+
+template<class T, class U>
+bool operator!=(linked_ptr<T> const& left, U const* right)
+{
+    return !(left == right);
+}
+
+template<class T, class U>
+bool operator!=(U const* left, linked_ptr<T> const& right)
+{
+    return !(left == right);
+}
+
+template<class T, class U>
+bool operator<(linked_ptr<T> const& left, U const* right)
+{
+    return left.get() < right;
+}
+
+template<class T, class U>
+bool operator<(U const* left, linked_ptr<T> const& right)
+{
+    return left < right.get();
 }
 
 template<class T>
-void linked_ptr<T>::bool_test_function() const
+bool operator==(linked_ptr<T> const& left, std::nullptr_t)
 {
+    return left.get() == nullptr;
 }
 
 template<class T>
-linked_ptr<T>::operator bool_type() const
+bool operator==(std::nullptr_t, linked_ptr<T> const& right)
 {
-    return mData != nullptr ? &linked_ptr<T>::bool_test_function : nullptr;
+    return right.get() == nullptr;
+}
+
+template<class T>
+bool operator!=(linked_ptr<T> const& left, std::nullptr_t)
+{
+    return left.get() != nullptr;
 }
 
+template<class T>
+bool operator!=(std::nullptr_t, linked_ptr<T> const& right)
+{
+    return right.get() != nullptr;
+}
 
-template<class T, class... Args>
-linked_ptr<T> make_linked(Args&&... args)
+    // what a key of linked_ptr_less points to
+template<class T>
+typename linked_ptr<T>::element_type const* linked_key(linked_ptr<T> const& key)
+{
+    return key.get();
+}
+
+template<class T>
+T const* linked_key(T const* key)
 {
-    return linked_ptr<T>(new T(std::forward<Args>(args)...));
+    return key;
 }
 
+template<class L, class R>
+bool linked_ptr_less::operator()(L const& left, R const& right) const
+{
+    return linked_key(left) < linked_key(right);
+}
 
 template<class T>
-bool operator==(linked_ptr<T> const& left, linked_ptr<T> const& right)
+std::size_t std::hash<linked_ptr<T>>::operator()(linked_ptr<T> const& ptr) const
 {
-    return left.get() == right.get();
+    return std::hash<typename linked_ptr<T>::element_type const*>()(ptr.get());
 }
 
 template<class T>
-bool operator!=(linked_ptr<T> const& left, linked_ptr<T> const& right)
+void swap(linked_ptr<T>& left, linked_ptr<T>& right)
 {
-    return !(left == right);
+    left.swap(right);
 }
 
 template<class T>
-bool operator<(linked_ptr<T> const& left, linked_ptr<T> const& right)
+void swap(weak_linked_ptr<T>& left, weak_linked_ptr<T>& right)
 {
-    return left.get() < right.get();
+    left.swap(right);
 }
 
 #endif
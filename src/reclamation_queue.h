@@ -0,0 +1,92 @@
+#ifndef SMART_POINTERS_RECLAMATION_QUEUE_H
+#define SMART_POINTERS_RECLAMATION_QUEUE_H
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+    // snapshot of what the queue went through
+struct reclamation_stats
+{
+        // objects queued and not destroyed yet,
+        // a batch being destroyed included
+    std::size_t depth{ 0 };
+    std::size_t peakDepth{ 0 };
+    unsigned long long enqueued{ 0 };
+    unsigned long long reclaimed{ 0 };
+        // objects destroyed right away because the queue was full
+    unsigned long long overflows{ 0 };
+    std::chrono::nanoseconds lastDrain{ 0 };
+    std::chrono::nanoseconds longestDrain{ 0 };
+};
+
+    // objects whose last owner is gone wait here to be destroyed later,
+    // by drain() or by the background thread started with start().
+    // At most capacity objects are pending, those of a batch being
+    // destroyed included. Beyond that the caller destroys the object
+    // itself, it never waits for the batch
+class reclamation_queue
+{
+public:
+    typedef void (*destroy_function)(void*);
+
+    explicit reclamation_queue(std::size_t capacity = 4096);
+        // stops the background thread and destroys whatever is left
+    ~reclamation_queue();
+
+    reclamation_queue(reclamation_queue const&) = delete;
+    reclamation_queue& operator=(reclamation_queue const&) = delete;
+
+    void enqueue(void* ptr, destroy_function destroy);
+        // destroys the queued objects, also the ones queued meanwhile
+        // by their destructors. Returns how many were destroyed
+    std::size_t drain();
+
+    void start();
+        // may be called from several threads, one joins the background
+        // thread and the others wait for it
+    void stop();
+
+    reclamation_stats stats() const;
+
+private:
+    struct entry
+    {
+        void* ptr;
+        destroy_function destroy;
+    };
+
+    std::size_t const mCapacity;
+    mutable std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    std::vector<entry> mPending;
+        // taken out of mPending, being destroyed
+    std::size_t mInFlight{ 0 };
+    reclamation_stats mStats;
+    bool mStopping{ false };
+        // serializes start() and stop()
+    std::mutex mControl;
+    std::thread mThread;
+
+    std::size_t run(std::vector<entry>& batch);
+    void background();
+};
+
+    // deleter that hands the object over to a reclamation_queue.
+    // It is a single pointer, so linked_ptr keeps it inline
+template<class T>
+struct deferred_delete
+{
+    explicit deferred_delete(reclamation_queue& queue);
+
+    void operator()(T* ptr) const;
+
+    reclamation_queue* queue;
+};
+
+#include "reclamation_queue.hpp"
+
+#endif
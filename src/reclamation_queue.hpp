@@ -0,0 +1,145 @@
+#ifndef SMART_POINTERS_RECLAMATION_QUEUE_CPP
+#define SMART_POINTERS_RECLAMATION_QUEUE_CPP
+
+#include <algorithm> // for max
+#include <utility> // for swap
+
+/*********************************************************/
+/*                   reclamation_queue                   */
+
+inline reclamation_queue::reclamation_queue(std::size_t capacity)
+    : mCapacity(capacity)
+{
+}
+
+inline reclamation_queue::~reclamation_queue()
+{
+    stop();
+    drain();
+}
+
+inline void reclamation_queue::enqueue(void* ptr, destroy_function destroy)
+{
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        if (mPending.size() + mInFlight < mCapacity)
+        {
+            mPending.push_back(entry{ ptr, destroy });
+            ++mStats.enqueued;
+            mStats.peakDepth = std::max(mStats.peakDepth, mPending.size() + mInFlight);
+            if (mPending.size() == 1)
+                mWakeUp.notify_one();
+            return;
+        }
+        ++mStats.overflows;
+    }
+    destroy(ptr);
+}
+
+inline std::size_t reclamation_queue::drain()
+{
+    std::size_t count{ 0 };
+    std::vector<entry> batch;
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> guard(mMutex);
+            if (mPending.empty())
+                break;
+            batch.swap(mPending);
+            mInFlight += batch.size();
+        }
+        count += run(batch);
+    }
+    return count;
+}
+
+inline void reclamation_queue::start()
+{
+    std::lock_guard<std::mutex> control(mControl);
+    std::lock_guard<std::mutex> guard(mMutex);
+    if (!mThread.joinable())
+    {
+        mStopping = false;
+        mThread = std::thread(&reclamation_queue::background, this);
+    }
+}
+
+inline void reclamation_queue::stop()
+{
+    std::lock_guard<std::mutex> control(mControl);
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mStopping = true;
+    }
+    mWakeUp.notify_one();
+    if (mThread.joinable())
+        mThread.join();
+}
+
+inline reclamation_stats reclamation_queue::stats() const
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    reclamation_stats stats = mStats;
+    stats.depth = mPending.size() + mInFlight;
+    return stats;
+}
+
+inline std::size_t reclamation_queue::run(std::vector<entry>& batch)
+{
+        // the objects are destroyed without the lock held,
+        // their destructors may queue more of them
+    std::chrono::steady_clock::time_point const begin = std::chrono::steady_clock::now();
+    for (entry const& item : batch)
+        item.destroy(item.ptr);
+    std::chrono::nanoseconds const spent = std::chrono::steady_clock::now() - begin;
+    std::size_t const count = batch.size();
+    batch.clear();
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    mInFlight -= count;
+    mStats.reclaimed += count;
+    mStats.lastDrain = spent;
+    mStats.longestDrain = std::max(mStats.longestDrain, spent);
+    return count;
+}
+
+inline void reclamation_queue::background()
+{
+    std::vector<entry> batch;
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        mWakeUp.wait(lock, [this]() { return mStopping || !mPending.empty(); });
+        if (mPending.empty())
+            return;
+        batch.swap(mPending);
+        mInFlight += batch.size();
+        lock.unlock();
+        run(batch);
+        lock.lock();
+    }
+}
+
+/*********************************************************/
+/*                    deferred_delete                    */
+
+template<class T>
+void destroy_deferred(void* ptr)
+{
+    delete static_cast<T*>(ptr);
+}
+
+template<class T>
+deferred_delete<T>::deferred_delete(reclamation_queue& queue)
+    : queue(&queue)
+{
+}
+
+template<class T>
+void deferred_delete<T>::operator()(T* ptr) const
+{
+    queue->enqueue(ptr, &destroy_deferred<T>);
+}
+
+#endif
@@ -31,4 +31,71 @@ public:
    }
 };
 
+   // non-virtual destructor, counts destroyed objects
+class CountedObject
+{
+public:
+   static int destroyed;
+   ~CountedObject()
+   {
+      ++destroyed;
+   }
+};
+
+int CountedObject::destroyed = 0;
+
+class CountedObjectDerive : public CountedObject
+{
+public:
+   CountedObjectDerive(string const& message): msg(message)
+   {
+   }
+   string msg;
+   ~CountedObjectDerive()
+   {
+      ++destroyed;
+   }
+};
+
+   // minimal allocator that counts bytes taken from and given back to it
+template<class T>
+class CountingAllocator
+{
+public:
+   typedef T value_type;
+
+   CountingAllocator(long* allocated): allocated(allocated)
+   {
+   }
+   template<class U>
+   CountingAllocator(CountingAllocator<U> const& rhs): allocated(rhs.allocated)
+   {
+   }
+
+   T* allocate(size_t n)
+   {
+      *allocated += n * sizeof(T);
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+   }
+   void deallocate(T* ptr, size_t n)
+   {
+      *allocated -= n * sizeof(T);
+      ::operator delete(ptr);
+   }
+
+   long* allocated;
+};
+
+template<class T, class U>
+bool operator==(CountingAllocator<T> const& left, CountingAllocator<U> const& right)
+{
+   return left.allocated == right.allocated;
+}
+
+template<class T, class U>
+bool operator!=(CountingAllocator<T> const& left, CountingAllocator<U> const& right)
+{
+   return !(left == right);
+}
+
 #endif
\ No newline at end of file
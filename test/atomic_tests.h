@@ -0,0 +1,132 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "atomic_linked_ptr.h"
+#include "TestObject.h"
+
+using std::cout;
+using std::endl;
+
+    // value that remembers whether it was already destroyed,
+    // the count is kept by all the threads
+struct Config
+{
+    static std::atomic<int> destroyed;
+    Config(int v)
+        : version(v)
+        , alive(true)
+    {
+    }
+    ~Config()
+    {
+        alive = false;
+        ++destroyed;
+    }
+    int version;
+    bool alive;
+};
+
+std::atomic<int> Config::destroyed{ 0 };
+
+class Atomic_Linked_Ptr_Tests : public ::testing::Test
+{
+protected:
+    int const THREADS;
+    int const MAX_ITERATIONS;
+
+public:
+    Atomic_Linked_Ptr_Tests()
+        : THREADS(4)
+        , MAX_ITERATIONS(5000)
+    {
+        Config::destroyed = 0;
+    }
+};
+
+TEST_F(Atomic_Linked_Ptr_Tests, Operations)
+{
+    cout << "TEST atomic_linked_ptr operations" << endl;
+
+    typedef atomic_linked_ptr<Config>::value_type config_ptr;
+    {
+        atomic_linked_ptr<Config> slot(make_concurrent_linked<Config>(1));
+        EXPECT_FALSE(slot.is_lock_free());
+        config_ptr first = slot.load();
+        EXPECT_EQ(1, first->version);
+        EXPECT_EQ(2, first.use_count());
+
+        slot.store(make_concurrent_linked<Config>(2));
+        EXPECT_TRUE(first.unique());
+        config_ptr second = slot.exchange(make_concurrent_linked<Config>(3));
+        EXPECT_EQ(2, second->version);
+        EXPECT_EQ(0, Config::destroyed);
+
+        cout << "Compare exchange" << endl;
+        config_ptr expected = first;
+        EXPECT_FALSE(slot.compare_exchange_strong(expected, make_concurrent_linked<Config>(4)));
+        EXPECT_EQ(3, expected->version);
+        EXPECT_EQ(1, Config::destroyed);
+        EXPECT_TRUE(slot.compare_exchange_weak(expected, second));
+        EXPECT_EQ(2, static_cast<config_ptr>(slot)->version);
+        EXPECT_EQ(2, second.use_count());
+        expected.reset();
+        EXPECT_EQ(2, Config::destroyed);
+
+        slot = config_ptr();
+        EXPECT_FALSE(slot.load());
+    }
+    EXPECT_EQ(4, Config::destroyed);
+
+    cout << "atomic_linked_ptr operations successful" << endl;
+}
+
+TEST_F(Atomic_Linked_Ptr_Tests, Readers_and_writers)
+{
+    cout << "TEST readers copying while writers replace" << endl;
+
+    typedef atomic_linked_ptr<Config, spinlock_pool<>>::value_type config_ptr;
+    {
+        atomic_linked_ptr<Config, spinlock_pool<>> slot(make_concurrent_linked<Config, spinlock_pool<>>(0));
+        std::atomic<bool> done{ false };
+        std::atomic<int> failures{ 0 };
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([&]()
+            {
+                while (!done.load())
+                {
+                    config_ptr current = slot.load();
+                    config_ptr copy(current);
+                    if (!copy->alive)
+                        ++failures;
+                }
+            });
+        }
+            // every writer bumps the version by one, none of the bumps is lost
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 2; ++t)
+        {
+            writers.emplace_back([&]()
+            {
+                for (int i = 0; i < MAX_ITERATIONS; ++i)
+                {
+                    config_ptr expected = slot.load();
+                    while (!slot.compare_exchange_weak(expected,
+                        make_concurrent_linked<Config, spinlock_pool<>>(expected->version + 1)))
+                    {
+                    }
+                }
+            });
+        }
+        for (std::thread& writer : writers)
+            writer.join();
+        done = true;
+        for (std::thread& thread : threads)
+            thread.join();
+        EXPECT_EQ(0, failures.load());
+        EXPECT_EQ(2 * MAX_ITERATIONS, slot.load()->version);
+    }
+
+    cout << "Readers copying while writers replace successful" << endl;
+}
@@ -0,0 +1,157 @@
+#include <thread>
+#include <vector>
+#include "biased_linked_ptr.h"
+#include "TestObject.h"
+
+using std::cout;
+using std::endl;
+
+class Biased_Linked_Ptr_Tests : public ::testing::Test
+{
+protected:
+    int const THREADS;
+    int const MAX_ITERATIONS;
+
+public:
+    Biased_Linked_Ptr_Tests()
+        : THREADS(8)
+        , MAX_ITERATIONS(20000)
+    {
+        CountedObject::destroyed = 0;
+    }
+};
+
+TEST_F(Biased_Linked_Ptr_Tests, Sub_rings)
+{
+    cout << "TEST owner thread and shared sub-rings" << endl;
+
+    {
+        biased_linked_ptr<CountedObject> source = make_biased_linked<CountedObject>();
+        biased_linked_ptr<CountedObject> local(source);
+        biased_linked_ptr<CountedObject> shared = source.share();
+        EXPECT_FALSE(local.shared());
+        EXPECT_TRUE(shared.shared());
+        EXPECT_EQ(3, source.use_count());
+
+        long seen = 0;
+        biased_linked_ptr<CountedObject> fromThread;
+        std::thread thread([&]()
+        {
+            biased_linked_ptr<CountedObject> copy(local);
+            seen = copy.use_count();
+            fromThread = copy;
+        });
+        thread.join();
+            // other threads only see the shared sub-ring
+        EXPECT_EQ(2, seen);
+        EXPECT_TRUE(fromThread.shared());
+        EXPECT_EQ(4, source.use_count());
+
+        cout << "Local sub-ring empties while shared owners remain" << endl;
+        source.reset();
+        local.reset();
+        EXPECT_EQ(0, CountedObject::destroyed);
+        EXPECT_EQ(2, shared.use_count());
+
+        cout << "Owner thread copies join the local sub-ring again" << endl;
+        biased_linked_ptr<CountedObject> again(shared);
+        EXPECT_FALSE(again.shared());
+        shared.reset();
+        fromThread.reset();
+        EXPECT_EQ(0, CountedObject::destroyed);
+        EXPECT_TRUE(again.unique());
+    }
+    EXPECT_EQ(1, CountedObject::destroyed);
+
+    cout << "Other threads see the owner thread's handles in unique()" << endl;
+    {
+        biased_linked_ptr<CountedObject> local = make_biased_linked<CountedObject>();
+        biased_linked_ptr<CountedObject> shared = local.share();
+        bool unique = true;
+        std::thread before([&]() { unique = shared.unique(); });
+        before.join();
+        EXPECT_FALSE(unique);
+        local.reset();
+        std::thread after([&]() { unique = shared.unique(); });
+        after.join();
+        EXPECT_TRUE(unique);
+    }
+
+    cout << "Swap across sub-rings" << endl;
+    CountedObject::destroyed = 0;
+    {
+        biased_linked_ptr<CountedObject> first = make_biased_linked<CountedObject>();
+        biased_linked_ptr<CountedObject> second = make_biased_linked<CountedObject>();
+        biased_linked_ptr<CountedObject> shared = second.share();
+        CountedObject* firstObject = first.get();
+        first.swap(shared);
+        EXPECT_TRUE(first.shared());
+        EXPECT_FALSE(shared.shared());
+        EXPECT_EQ(firstObject, shared.get());
+        EXPECT_EQ(second.get(), first.get());
+        EXPECT_EQ(2, second.use_count());
+        EXPECT_TRUE(shared.unique());
+    }
+    EXPECT_EQ(2, CountedObject::destroyed);
+
+    cout << "Owner thread and shared sub-rings successful" << endl;
+}
+
+TEST_F(Biased_Linked_Ptr_Tests, Last_owner_on_other_thread)
+{
+    cout << "TEST last biased owner released on another thread" << endl;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        biased_linked_ptr<CountedObject> source(new CountedObject);
+        biased_linked_ptr<CountedObject> first = source.share();
+        biased_linked_ptr<CountedObject> second = source.share();
+        std::thread firstThread([&first]() { first.reset(); });
+        std::thread secondThread([&second]() { second.reset(); });
+        source.reset();
+        firstThread.join();
+        secondThread.join();
+    }
+    EXPECT_EQ(1000, CountedObject::destroyed);
+
+    cout << "Last biased owner released on another thread successful" << endl;
+}
+
+TEST_F(Biased_Linked_Ptr_Tests, Stress)
+{
+    cout << "TEST owner thread copying while others share" << endl;
+
+    {
+        biased_linked_ptr<CountedObject> source(new CountedObject);
+        biased_linked_ptr<CountedObject> const shared = source.share();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([this, &shared, t]()
+            {
+                std::vector<biased_linked_ptr<CountedObject>> local;
+                for (int i = 0; i < MAX_ITERATIONS / THREADS; ++i)
+                {
+                    local.push_back(shared);
+                    if (local.size() > static_cast<size_t>(4 + t))
+                        local.erase(local.begin() + (i % local.size()));
+                }
+            });
+        }
+        std::vector<biased_linked_ptr<CountedObject>> owned;
+        for (int i = 0; i < MAX_ITERATIONS; ++i)
+        {
+            owned.push_back(source);
+            if (owned.size() > 16)
+                owned.erase(owned.begin() + (i % owned.size()));
+        }
+        owned.clear();
+        for (std::thread& thread : threads)
+            thread.join();
+        EXPECT_EQ(2, source.use_count());
+        EXPECT_EQ(0, CountedObject::destroyed);
+    }
+    EXPECT_EQ(1, CountedObject::destroyed);
+
+    cout << "Owner thread copying while others share successful" << endl;
+}
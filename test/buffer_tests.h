@@ -0,0 +1,99 @@
+#include <cstring>
+#include <vector>
+#include "linked_buffer.h"
+#include "TestObject.h"
+
+using std::cout;
+using std::endl;
+
+class Linked_Buffer_Tests : public ::testing::Test
+{
+protected:
+    std::size_t const PACKET_SIZE;
+    std::size_t const FIELD_SIZE;
+
+public:
+    Linked_Buffer_Tests()
+        : PACKET_SIZE(64 * 1024)
+        , FIELD_SIZE(128)
+    {
+        CountedObject::destroyed = 0;
+    }
+};
+
+TEST_F(Linked_Buffer_Tests, Slicing)
+{
+    cout << "TEST slices share the buffer" << endl;
+
+    std::vector<linked_buffer> fields;
+    char const* first = nullptr;
+    {
+        linked_buffer packet(PACKET_SIZE);
+        EXPECT_EQ(PACKET_SIZE, packet.size());
+        EXPECT_EQ(0, packet[PACKET_SIZE - 1]);
+        for (std::size_t i = 0; i < PACKET_SIZE; ++i)
+            packet[i] = static_cast<char>(i / FIELD_SIZE);
+        first = packet.data();
+
+        for (std::size_t offset = 0; offset < PACKET_SIZE; offset += FIELD_SIZE)
+            fields.push_back(packet.slice(offset, FIELD_SIZE));
+        EXPECT_EQ(static_cast<long>(fields.size() + 1), packet.use_count());
+    }
+    EXPECT_EQ(PACKET_SIZE / FIELD_SIZE, fields.size());
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        EXPECT_EQ(first + i * FIELD_SIZE, fields[i].data());
+        EXPECT_EQ(FIELD_SIZE, fields[i].size());
+        EXPECT_EQ(static_cast<char>(i), fields[i][FIELD_SIZE - 1]);
+    }
+
+    cout << "Slices of slices stay in the same ring" << endl;
+    linked_buffer const header = fields[3].slice(4, 8);
+    linked_buffer const tail = header.slice(6);
+    EXPECT_EQ(first + 3 * FIELD_SIZE + 10, tail.data());
+    EXPECT_EQ(2u, tail.size());
+    EXPECT_EQ(static_cast<long>(fields.size() + 2), tail.use_count());
+    fields.clear();
+    EXPECT_EQ(2, tail.use_count());
+
+    cout << "Slices are clipped to the view" << endl;
+    EXPECT_EQ(2u, header.slice(6, 100).size());
+    EXPECT_TRUE(header.slice(100).empty());
+    EXPECT_TRUE(linked_buffer().slice(1, 1).empty());
+
+    cout << "Slices share the buffer successful" << endl;
+}
+
+TEST_F(Linked_Buffer_Tests, Owners)
+{
+    cout << "TEST buffers kept alive by their owner" << endl;
+
+    struct Packet : public CountedObject
+    {
+        char bytes[256];
+    };
+    {
+        linked_buffer payload;
+        {
+            linked_ptr<Packet> packet(new Packet);
+            std::strcpy(packet->bytes, "header:payload");
+            linked_buffer all(packet, packet->bytes, std::strlen(packet->bytes));
+            payload = all.slice(7);
+        }
+        EXPECT_EQ(0, CountedObject::destroyed);
+        EXPECT_TRUE(payload.unique());
+        EXPECT_EQ(std::string("payload"), std::string(payload.begin(), payload.end()));
+    }
+    EXPECT_EQ(1, CountedObject::destroyed);
+
+    cout << "Buffer adopts an array" << endl;
+    linked_ptr<char[]> storage(new char[16]);
+    linked_buffer buffer(std::move(storage), 16);
+    EXPECT_EQ(nullptr, storage.get());
+    EXPECT_TRUE(buffer.unique());
+    buffer.reset();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(nullptr, buffer.data());
+
+    cout << "Buffers kept alive by their owner successful" << endl;
+}
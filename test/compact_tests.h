@@ -0,0 +1,54 @@
+#include <vector>
+#include "compact_linked_ptr.h"
+#include "TestObject.h"
+
+using std::cout;
+using std::endl;
+
+class Compact_Linked_Ptr_Tests : public ::testing::Test
+{
+protected:
+    int const MAX_ITERATIONS;
+    char const* hello;
+
+public:
+    Compact_Linked_Ptr_Tests()
+        : MAX_ITERATIONS(1000)
+        , hello("Hello")
+    {
+        CountedObject::destroyed = 0;
+    }
+};
+
+TEST_F(Compact_Linked_Ptr_Tests, Relocation_and_deleters)
+{
+    cout << "TEST compact relocation and custom deleters" << endl;
+
+    static_assert(sizeof(compact_linked_ptr<CountedObject>) == 2 * sizeof(void*),
+        "compact handle is a pointer and a header");
+    {
+        compact_linked_ptr<CountedObject> ptr = make_compact_linked<CountedObject>();
+        std::vector<compact_linked_ptr<CountedObject>> owners;
+        for (int i = 0; i < MAX_ITERATIONS; ++i)
+            owners.push_back(ptr);
+        std::vector<compact_linked_ptr<CountedObject>> moved(std::move(owners));
+        moved.insert(moved.begin(), std::move(ptr));
+        EXPECT_EQ(MAX_ITERATIONS + 1, moved.back().use_count());
+        moved.erase(moved.begin(), moved.begin() + MAX_ITERATIONS);
+        EXPECT_TRUE(moved.front().unique());
+        EXPECT_EQ(0, CountedObject::destroyed);
+    }
+    EXPECT_EQ(1, CountedObject::destroyed);
+
+    int deleted = 0;
+    {
+        compact_linked_ptr<TestObject> ptr(new TestObject(hello),
+            [&deleted](TestObject* object) { ++deleted; delete object; });
+        compact_linked_ptr<TestObject> copy(ptr);
+        ptr.reset();
+        EXPECT_EQ(0, deleted);
+    }
+    EXPECT_EQ(1, deleted);
+
+    cout << "Compact relocation and custom deleters successful" << endl;
+}
@@ -0,0 +1,138 @@
+#include <thread>
+#include <vector>
+#include "concurrent_linked_ptr.h"
+#include "TestObject.h"
+
+using std::cout;
+using std::endl;
+
+class Concurrent_Linked_Ptr_Tests : public ::testing::Test
+{
+protected:
+    int const THREADS;
+    int const MAX_ITERATIONS;
+
+public:
+    Concurrent_Linked_Ptr_Tests()
+        : THREADS(8)
+        , MAX_ITERATIONS(20000)
+    {
+    }
+
+        // every thread copies the shared pointer, copies and swaps its own
+        // copies and drops them in a different order than they were made
+    template<class Ptr>
+    void hammer_ring(Ptr const& source)
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([this, &source, t]()
+            {
+                std::vector<Ptr> local;
+                for (int i = 0; i < MAX_ITERATIONS; ++i)
+                {
+                    local.push_back(source);
+                    if (i % 3 == 0)
+                        local.push_back(local.back());
+                    if (i % 5 == 0 && local.size() > 1)
+                        local.front().swap(local.back());
+                    if (local.size() > static_cast<size_t>(8 + t))
+                        local.erase(local.begin() + (i % local.size()));
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+};
+
+TEST_F(Concurrent_Linked_Ptr_Tests, Stress_mutex_pool)
+{
+    cout << "TEST many threads sharing one ring" << endl;
+
+    CountedObject::destroyed = 0;
+    concurrent_linked_ptr<CountedObject> source(new CountedObject);
+    hammer_ring(source);
+    EXPECT_TRUE(source.unique());
+    EXPECT_EQ(1, source.use_count());
+    EXPECT_EQ(0, CountedObject::destroyed);
+    source.reset();
+    EXPECT_EQ(1, CountedObject::destroyed);
+
+    cout << "Many threads sharing one ring successful" << endl;
+}
+
+TEST_F(Concurrent_Linked_Ptr_Tests, Last_owner_on_other_thread)
+{
+    cout << "TEST last owner released on another thread" << endl;
+
+    CountedObject::destroyed = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        concurrent_linked_ptr<CountedObject> source = make_concurrent_linked<CountedObject>();
+        concurrent_linked_ptr<CountedObject> first(source);
+        concurrent_linked_ptr<CountedObject> second(source);
+        source.reset();
+        std::thread firstThread([&first]() { first.reset(); });
+        std::thread secondThread([&second]() { second.reset(); });
+        firstThread.join();
+        secondThread.join();
+    }
+    EXPECT_EQ(1000, CountedObject::destroyed);
+
+    cout << "Last owner released on another thread successful" << endl;
+}
+
+TEST_F(Concurrent_Linked_Ptr_Tests, Stress_spinlock_pool)
+{
+    cout << "TEST many threads sharing one ring guarded by a spinlock" << endl;
+
+    CountedObject::destroyed = 0;
+    concurrent_linked_ptr<CountedObject, spinlock_pool<>> source(new CountedObject);
+    hammer_ring(source);
+    EXPECT_TRUE(source.unique());
+    EXPECT_EQ(1, source.use_count());
+    EXPECT_EQ(0, CountedObject::destroyed);
+    source.reset();
+    EXPECT_EQ(1, CountedObject::destroyed);
+
+    cout << "Many threads sharing one ring guarded by a spinlock successful" << endl;
+}
+
+TEST_F(Concurrent_Linked_Ptr_Tests, Assignment_under_contention)
+{
+    cout << "TEST assignment while other threads share the ring" << endl;
+
+    CountedObject::destroyed = 0;
+    {
+        concurrent_linked_ptr<CountedObject> source(new CountedObject);
+        std::vector<concurrent_linked_ptr<CountedObject>> own;
+        for (int t = 0; t < THREADS; ++t)
+            own.push_back(make_concurrent_linked<CountedObject>());
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t)
+        {
+            threads.emplace_back([this, &source, &own, t]()
+            {
+                concurrent_linked_ptr<CountedObject> first;
+                concurrent_linked_ptr<CountedObject> second;
+                for (int i = 0; i < MAX_ITERATIONS; ++i)
+                {
+                    first = source;
+                    second = first;
+                    first = std::move(second);
+                    second = own[t];
+                    second = first;
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        EXPECT_TRUE(source.unique());
+        EXPECT_EQ(0, CountedObject::destroyed);
+    }
+    EXPECT_EQ(1 + THREADS, CountedObject::destroyed);
+
+    cout << "Assignment while other threads share the ring successful" << endl;
+}
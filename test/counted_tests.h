@@ -0,0 +1,61 @@
+#include "counted_linked_ptr.h"
+#include "TestObject.h"
+
+using std::cout;
+using std::endl;
+
+class Counted_Linked_Ptr_Tests : public ::testing::Test
+{
+protected:
+    char const* hello;
+
+public:
+    Counted_Linked_Ptr_Tests()
+        : hello("Hello")
+    {
+    }
+};
+
+TEST_F(Counted_Linked_Ptr_Tests, Custom_deleter)
+{
+    cout << "TEST counted custom deleter" << endl;
+
+    bool deleted = false;
+    {
+        counted_linked_ptr<TestObject> withDeleter(new TestObject(hello),
+            [&deleted](TestObject* ptr) { deleted = true; delete ptr; });
+        counted_linked_ptr<TestObject> copy = withDeleter;
+        EXPECT_EQ(2, copy.use_count());
+    }
+    EXPECT_TRUE(deleted);
+
+    cout << "Counted custom deleter successful" << endl;
+}
+
+TEST_F(Counted_Linked_Ptr_Tests, Make_counted_linked)
+{
+    cout << "TEST counted make_counted_linked" << endl;
+
+    CountedObject::destroyed = 0;
+    {
+        counted_linked_ptr<CountedObjectDerive> made = make_counted_linked<CountedObjectDerive>(hello);
+        EXPECT_EQ(hello, made->msg);
+        EXPECT_TRUE(made.unique());
+        counted_linked_ptr<CountedObjectDerive> copy(made);
+        EXPECT_FALSE(made.unique());
+        EXPECT_EQ(2, copy.use_count());
+    }
+    EXPECT_EQ(2, CountedObject::destroyed);
+
+    counted_linked_ptr<TestObject> emptyPtr;
+    EXPECT_FALSE(emptyPtr.unique());
+
+        // the block is given back when the constructor throws
+    struct Throwing
+    {
+        Throwing() { throw std::runtime_error("construction"); }
+    };
+    EXPECT_THROW(make_counted_linked<Throwing>(), std::runtime_error);
+
+    cout << "Counted make_counted_linked successful" << endl;
+}
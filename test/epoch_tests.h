@@ -0,0 +1,117 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "epoch_publisher.h"
+#include "TestObject.h"
+
+using std::cout;
+using std::endl;
+
+class Epoch_Publisher_Tests : public ::testing::Test
+{
+protected:
+    int const THREADS;
+    int const MAX_ITERATIONS;
+
+public:
+    Epoch_Publisher_Tests()
+        : THREADS(4)
+        , MAX_ITERATIONS(2000)
+    {
+        CountedObject::destroyed = 0;
+    }
+};
+
+    // snapshot that checks it's still alive when read
+struct Snapshot : public CountedObject
+{
+    Snapshot(int v)
+        : value(v)
+        , alive(true)
+    {
+    }
+    ~Snapshot()
+    {
+        alive = false;
+    }
+    int value;
+    bool alive;
+};
+
+TEST_F(Epoch_Publisher_Tests, Delete_waits_for_readers)
+{
+    cout << "TEST last owner's delete waits for the readers" << endl;
+
+    epoch_domain domain;
+    {
+        epoch_publisher<Snapshot const> publisher(domain, make_linked<Snapshot const>(1));
+        {
+            epoch_guard guard(domain);
+            Snapshot const* snapshot = publisher.read(guard);
+            EXPECT_EQ(1, snapshot->value);
+
+            publisher.publish(make_linked<Snapshot const>(2));
+            EXPECT_EQ(0, CountedObject::destroyed);
+            EXPECT_EQ(1u, domain.retired());
+            EXPECT_TRUE(snapshot->alive);
+            EXPECT_EQ(0u, domain.reclaim());
+
+                // a newer reader sees the new snapshot
+            epoch_guard newer(domain);
+            EXPECT_EQ(2, publisher.read(newer)->value);
+        }
+        EXPECT_EQ(1u, domain.reclaim());
+        EXPECT_EQ(1, CountedObject::destroyed);
+
+        cout << "Published object owned elsewhere too" << endl;
+        linked_ptr<Snapshot const> kept = make_linked<Snapshot const>(3);
+        publisher.publish(kept);
+        EXPECT_EQ(2, CountedObject::destroyed);
+        publisher.publish(make_linked<Snapshot const>(4));
+        EXPECT_EQ(2, CountedObject::destroyed);
+        EXPECT_TRUE(kept.unique());
+    }
+        // nobody reads anymore, the publisher's owner goes right away
+    EXPECT_EQ(4, CountedObject::destroyed);
+    EXPECT_EQ(0u, domain.retired());
+
+    cout << "Last owner's delete waits for the readers successful" << endl;
+}
+
+TEST_F(Epoch_Publisher_Tests, Readers_and_writer)
+{
+    cout << "TEST readers racing the writer" << endl;
+
+    epoch_domain domain;
+    {
+        epoch_publisher<Snapshot const> publisher(domain, make_linked<Snapshot const>(0));
+        std::atomic<bool> done{ false };
+        std::atomic<int> failures{ 0 };
+        std::vector<std::thread> readers;
+        for (int t = 0; t < THREADS; ++t)
+        {
+            readers.emplace_back([&]()
+            {
+                int last = 0;
+                while (!done.load())
+                {
+                    epoch_guard guard(domain);
+                    Snapshot const* snapshot = publisher.read(guard);
+                    if (!snapshot->alive || snapshot->value < last)
+                        ++failures;
+                    last = snapshot->value;
+                }
+            });
+        }
+        for (int i = 1; i <= MAX_ITERATIONS; ++i)
+            publisher.publish(make_linked<Snapshot const>(i));
+        done = true;
+        for (std::thread& reader : readers)
+            reader.join();
+        EXPECT_EQ(0, failures.load());
+    }
+    domain.reclaim();
+    EXPECT_EQ(MAX_ITERATIONS + 1, CountedObject::destroyed);
+
+    cout << "Readers racing the writer successful" << endl;
+}
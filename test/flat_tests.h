@@ -0,0 +1,138 @@
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "linked_flat_table.h"
+#include "TestObject.h"
+
+using std::cout;
+using std::endl;
+
+class Linked_Flat_Table_Tests : public ::testing::Test
+{
+protected:
+    int const MAX_ITERATIONS;
+
+public:
+    Linked_Flat_Table_Tests()
+        : MAX_ITERATIONS(5000)
+    {
+        CountedObject::destroyed = 0;
+    }
+};
+
+TEST_F(Linked_Flat_Table_Tests, Hash)
+{
+    cout << "TEST hash of linked pointers" << endl;
+
+    linked_ptr<CountedObject> first(new CountedObject);
+    linked_ptr<CountedObject> second(new CountedObject);
+    EXPECT_EQ(std::hash<CountedObject const*>()(first.get()), std::hash<linked_ptr<CountedObject>>()(first));
+
+    std::unordered_set<linked_ptr<CountedObject>> set;
+    set.insert(first);
+    set.insert(second);
+    set.insert(linked_ptr<CountedObject>(first));
+    EXPECT_EQ(2u, set.size());
+    EXPECT_EQ(1u, set.count(second));
+
+    cout << "Hash of linked pointers successful" << endl;
+}
+
+TEST_F(Linked_Flat_Table_Tests, Set)
+{
+    cout << "TEST flat set of linked pointers" << endl;
+
+    std::vector<linked_ptr<CountedObject>> objects;
+    for (int i = 0; i < MAX_ITERATIONS; ++i)
+        objects.push_back(linked_ptr<CountedObject>(new CountedObject));
+    {
+        linked_ptr_flat_set<CountedObject> set;
+        for (linked_ptr<CountedObject> const& ptr : objects)
+            EXPECT_TRUE(set.insert(ptr).second);
+        EXPECT_FALSE(set.insert(objects.front()).second);
+        EXPECT_FALSE(set.insert(linked_ptr<CountedObject>()).second);
+        EXPECT_EQ(objects.size(), set.size());
+            // growing moved every slot, the rings must have followed
+        for (linked_ptr<CountedObject> const& ptr : objects)
+        {
+            EXPECT_EQ(2, ptr.use_count());
+            EXPECT_TRUE(set.contains(ptr.get()));
+        }
+
+        cout << "Erase by raw pointer shifts the following slots" << endl;
+        for (std::size_t i = 0; i < objects.size(); i += 2)
+            EXPECT_EQ(1u, set.erase(objects[i].get()));
+        EXPECT_EQ(0u, set.erase(objects.front().get()));
+        EXPECT_EQ(objects.size() / 2, set.size());
+        for (std::size_t i = 0; i < objects.size(); ++i)
+        {
+            EXPECT_EQ(i % 2 == 1, set.contains(objects[i]));
+            EXPECT_EQ(i % 2 == 1 ? 2 : 1, objects[i].use_count());
+        }
+
+        std::size_t count = 0;
+        for (linked_ptr<CountedObject> const& ptr : set)
+        {
+            EXPECT_EQ(2, ptr.use_count());
+            ++count;
+        }
+        EXPECT_EQ(set.size(), count);
+
+        cout << "Copies and moves of the set" << endl;
+        linked_ptr_flat_set<CountedObject> copy(set);
+        EXPECT_EQ(3, objects[1].use_count());
+        linked_ptr_flat_set<CountedObject> moved(std::move(copy));
+        EXPECT_TRUE(copy.empty());
+        EXPECT_EQ(3, objects[1].use_count());
+        EXPECT_TRUE(moved.find(objects[1].get()) != moved.end());
+    }
+    for (linked_ptr<CountedObject> const& ptr : objects)
+        EXPECT_TRUE(ptr.unique());
+    EXPECT_EQ(0, CountedObject::destroyed);
+
+    cout << "The set keeps the last owners" << endl;
+    {
+        linked_ptr_flat_set<CountedObject> set;
+        for (linked_ptr<CountedObject>& ptr : objects)
+            set.insert(std::move(ptr));
+        objects.clear();
+        EXPECT_EQ(0, CountedObject::destroyed);
+    }
+    EXPECT_EQ(MAX_ITERATIONS, CountedObject::destroyed);
+
+    cout << "Flat set of linked pointers successful" << endl;
+}
+
+TEST_F(Linked_Flat_Table_Tests, Map)
+{
+    cout << "TEST flat map keyed by linked pointers" << endl;
+
+    {
+        std::vector<linked_ptr<CountedObject>> keys;
+        linked_ptr_flat_map<CountedObject, std::string> map;
+        for (int i = 0; i < MAX_ITERATIONS; ++i)
+        {
+            keys.push_back(linked_ptr<CountedObject>(new CountedObject));
+            map[keys.back()] = std::to_string(i);
+        }
+        EXPECT_FALSE(map.insert(keys[3], "three").second);
+        EXPECT_EQ(std::string("3"), map.find(keys[3].get())->second);
+        EXPECT_EQ(2, keys[3].use_count());
+
+        for (int i = 0; i < MAX_ITERATIONS; i += 3)
+            map.erase(keys[i]);
+        for (int i = 0; i < MAX_ITERATIONS; ++i)
+        {
+            linked_ptr_flat_map<CountedObject, std::string>::iterator it = map.find(keys[i]);
+            if (i % 3 == 0)
+                EXPECT_TRUE(it == map.end());
+            else
+                EXPECT_EQ(std::to_string(i), it->second);
+        }
+        keys.clear();
+        EXPECT_EQ((MAX_ITERATIONS + 2) / 3, CountedObject::destroyed);
+    }
+    EXPECT_EQ(MAX_ITERATIONS, CountedObject::destroyed);
+
+    cout << "Flat map keyed by linked pointers successful" << endl;
+}
@@ -1,4 +1,6 @@
 #include <stdio.h>
+#include <algorithm>
+#include <functional>
 #include "linked_ptr.h"
 #include "TestObject.h"
 
@@ -410,6 +412,15 @@ TEST_F(Linked_Ptr_General_Tests, MakeLinked)
     EXPECT_EQ(hello, linkedObj->msg) << ERROR_EQUALITY;
     EXPECT_TRUE(linkedObj.unique()) << ERROR_NOT_UNIQUE;
 
+    cout << "Destroy object through base pointer without virtual destructor" << endl;
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<CountedObject> base = make_linked<CountedObjectDerive>(hello);
+        linked_ptr<CountedObject> baseCopy(base);
+        EXPECT_EQ(2, base.use_count()) << ERROR_USE_COUNT;
+    }
+    EXPECT_EQ(2, CountedObject::destroyed) << ERROR_FUNC;
+
     cout << "make_linked successful" << endl;
 }
 
@@ -434,3 +445,765 @@ TEST_F(Linked_Ptr_General_Tests, Move)
 
     cout << "Move successful" << endl;
 }
+
+TEST_F(Linked_Ptr_General_Tests, Move_in_ring)
+{
+    cout << "TEST move of a pointer inside a ring" << endl;
+
+    EXPECT_TRUE(std::is_nothrow_move_constructible<linked_ptr<TestObject>>::value) << ERROR_FUNC;
+    EXPECT_TRUE(std::is_nothrow_move_assignable<linked_ptr<TestObject>>::value) << ERROR_FUNC;
+
+    linked_ptr<TestObject> p_to_copy1(p_to);
+    linked_ptr<TestObject> p_to_copy2(p_to);
+    linked_ptr<TestObject> p_to_moved(std::move(p_to_copy1));
+    EXPECT_EQ(nullptr, p_to_copy1.get()) << ERROR_EQUALITY;
+    EXPECT_TRUE(p_to_copy1.unique()) << ERROR_NOT_UNIQUE;
+    EXPECT_EQ(p_to.get(), p_to_moved.get()) << ERROR_EQUALITY;
+    EXPECT_EQ(3, p_to.use_count()) << ERROR_USE_COUNT;
+
+    cout << "Move assign pointer to the same data" << endl;
+    p_to_copy2 = std::move(p_to_moved);
+    EXPECT_EQ(nullptr, p_to_moved.get()) << ERROR_EQUALITY;
+    EXPECT_EQ(p_to.get(), p_to_copy2.get()) << ERROR_EQUALITY;
+    EXPECT_EQ(2, p_to.use_count()) << ERROR_USE_COUNT;
+
+    cout << "Move into base class pointer" << endl;
+    linked_ptr<TestObjectDerive> r_tod_copy(r_tod);
+    linked_ptr<TestObject> r_to(std::move(r_tod_copy));
+    EXPECT_EQ(nullptr, r_tod_copy.get()) << ERROR_EQUALITY;
+    EXPECT_EQ(2, r_tod.use_count()) << ERROR_USE_COUNT;
+
+    cout << "Grow vector of pointers to the same data" << endl;
+    {
+        std::vector<linked_ptr<TestObject>> vp;
+        for (int i = 0; i < MAX_ITERATIONS; ++i)
+            vp.push_back(p_to);
+        EXPECT_EQ(MAX_ITERATIONS + 2, p_to.use_count()) << ERROR_USE_COUNT;
+    }
+    EXPECT_EQ(2, p_to.use_count()) << ERROR_USE_COUNT;
+
+    cout << "Move in ring successful" << endl;
+}
+
+TEST_F(Linked_Ptr_General_Tests, Swap_in_ring)
+{
+    cout << "TEST swap of nodes in place" << endl;
+
+    cout << "Neighbour nodes" << endl;
+    {
+        list_node first;
+        list_node second(first);
+        list_node third(second);
+        second.swap(first);
+        first.swap(second);
+        third.swap(first);
+        EXPECT_EQ(3, first.use_count()) << ERROR_USE_COUNT;
+        EXPECT_EQ(3, second.use_count()) << ERROR_USE_COUNT;
+        EXPECT_EQ(3, third.use_count()) << ERROR_USE_COUNT;
+        second.unlink();
+        EXPECT_EQ(2, first.use_count()) << ERROR_USE_COUNT;
+        third.unlink();
+        EXPECT_TRUE(first.unique()) << ERROR_UNIQUE;
+    }
+
+    cout << "Nodes of different rings" << endl;
+    {
+        linked_ptr<TestObject> first(new TestObject(hello));
+        linked_ptr<TestObject> second(new TestObject(goodbye));
+        std::vector<linked_ptr<TestObject>> owners(3, first);
+        owners.push_back(second);
+        owners.push_back(second);
+        swap(owners[1], owners[3]);
+        EXPECT_EQ(goodbye, owners[1]->msg) << ERROR_EQUALITY;
+        EXPECT_EQ(4, first.use_count()) << ERROR_USE_COUNT;
+        EXPECT_EQ(3, owners[1].use_count()) << ERROR_USE_COUNT;
+        owners.clear();
+        EXPECT_TRUE(first.unique()) << ERROR_UNIQUE;
+        EXPECT_TRUE(second.unique()) << ERROR_UNIQUE;
+    }
+
+    cout << "Weak nodes keep behind the owners" << endl;
+    {
+        linked_ptr<TestObject> first(new TestObject(hello));
+        linked_ptr<TestObject> second(new TestObject(goodbye));
+        weak_linked_ptr<TestObject> weakFirst(first);
+        weak_linked_ptr<TestObject> weakFirstCopy(weakFirst);
+        weak_linked_ptr<TestObject> weakSecond(second);
+        weakFirstCopy.swap(weakFirst);
+        swap(weakFirst, weakSecond);
+        EXPECT_EQ(goodbye, weakFirst.lock()->msg) << ERROR_EQUALITY;
+        EXPECT_TRUE(first.unique()) << ERROR_UNIQUE;
+        EXPECT_TRUE(second.unique()) << ERROR_UNIQUE;
+        first.reset();
+        EXPECT_TRUE(weakSecond.expired()) << ERROR_FUNC;
+        EXPECT_TRUE(weakFirstCopy.expired()) << ERROR_FUNC;
+        EXPECT_FALSE(weakFirst.expired()) << ERROR_FUNC;
+    }
+
+    cout << "Sort of pointers" << endl;
+    {
+        std::vector<linked_ptr<TestObjectDerive>> vp;
+        for (int i = 0; i < MAX_ITERATIONS; ++i)
+            vp.push_back(linked_ptr<TestObjectDerive>(new TestObjectDerive(hello, (i * 7919) % MAX_ITERATIONS)));
+        std::vector<linked_ptr<TestObjectDerive>> copies(vp);
+        std::sort(vp.begin(), vp.end(), [](linked_ptr<TestObjectDerive> const& left, linked_ptr<TestObjectDerive> const& right)
+        {
+            return left->value < right->value;
+        });
+        for (int i = 1; i < MAX_ITERATIONS; ++i)
+            EXPECT_LE(vp[i - 1]->value, vp[i]->value) << ERROR_LESS;
+        for (linked_ptr<TestObjectDerive> const& ptr : vp)
+            EXPECT_EQ(2, ptr.use_count()) << ERROR_USE_COUNT;
+        copies.clear();
+        for (linked_ptr<TestObjectDerive> const& ptr : vp)
+            EXPECT_TRUE(ptr.unique()) << ERROR_UNIQUE;
+    }
+
+    cout << "Swap in ring successful" << endl;
+}
+
+TEST_F(Linked_Ptr_General_Tests, AllocateLinked)
+{
+    cout << "TEST allocate_linked" << endl;
+
+    long allocated = 0;
+    CountingAllocator<TestObject> alloc(&allocated);
+    {
+        linked_ptr<TestObject> linkedObj = allocate_linked<TestObjectDerive>(alloc, hello, value1);
+        EXPECT_NE(0, allocated) << ERROR_FUNC;
+        EXPECT_EQ(hello, linkedObj->msg) << ERROR_EQUALITY;
+        EXPECT_TRUE(linkedObj.unique()) << ERROR_NOT_UNIQUE;
+
+        linked_ptr<TestObject> linkedObjCopy(linkedObj);
+        linkedObj.reset();
+        EXPECT_NE(0, allocated) << ERROR_FUNC;
+        EXPECT_EQ(hello, linkedObjCopy->msg) << ERROR_EQUALITY;
+    }
+    EXPECT_EQ(0, allocated) << "Memory not returned to the allocator!!" << endl;
+
+    cout << "allocate_linked successful" << endl;
+}
+
+static int deletedByFunction = 0;
+
+static void delete_test_object(TestObject* ptr)
+{
+    ++deletedByFunction;
+    delete ptr;
+}
+
+struct Labeled
+{
+    int label{ 0 };
+};
+
+struct Ranked
+{
+    int rank{ 1 };
+};
+
+    // Ranked doesn't start the object
+struct RankedObject : public CountedObject, public Labeled, public Ranked
+{
+};
+
+TEST_F(Linked_Ptr_General_Tests, CustomDeleters)
+{
+    cout << "TEST custom deleters" << endl;
+
+    cout << "Function pointer deleter" << endl;
+    deletedByFunction = 0;
+    {
+        linked_ptr<TestObject> linkedObj(new TestObject(hello), &delete_test_object);
+        linked_ptr<TestObject> linkedObjCopy(linkedObj);
+        linkedObj.reset();
+        EXPECT_EQ(0, deletedByFunction) << ERROR_FUNC;
+    }
+    EXPECT_EQ(1, deletedByFunction) << ERROR_FUNC;
+
+    cout << "Empty functor deleter" << endl;
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<CountedObject> linkedObj(new CountedObject, std::default_delete<CountedObject>());
+        linked_ptr<CountedObject> linkedObjCopy = linkedObj;
+    }
+    EXPECT_EQ(1, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Deleter too big to be stored inline" << endl;
+    int deleted = 0;
+    std::string name(goodbye);
+    {
+        linked_ptr<TestObject> linkedObj(new TestObject(hello),
+            [&deleted, name](TestObject* ptr) { deleted += static_cast<int>(name.size()); delete ptr; });
+        linked_ptr<TestObject> linkedObjCopy(linkedObj);
+        linkedObj.reset(new TestObject(goodbye), &delete_test_object);
+    }
+    EXPECT_EQ(static_cast<int>(name.size()), deleted) << ERROR_FUNC;
+
+    cout << "Deleter is given the pointer it was created for" << endl;
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<CountedObject> base(new CountedObjectDerive(hello));
+        std::unique_ptr<CountedObjectDerive> uniObj(new CountedObjectDerive(goodbye));
+        linked_ptr<CountedObject> baseFromUnique(std::move(uniObj));
+    }
+    EXPECT_EQ(4, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Owner pointing to a base placed after another one" << endl;
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<Ranked> ranked(new RankedObject);
+        linked_ptr<Ranked> copy(ranked);
+        weak_linked_ptr<Ranked> weak(copy);
+        ranked.reset();
+        EXPECT_EQ(0, CountedObject::destroyed) << ERROR_FUNC;
+        linked_ptr<RankedObject> whole = static_linked_cast<RankedObject>(std::move(copy));
+        EXPECT_TRUE(whole.unique()) << ERROR_UNIQUE;
+        linked_ptr<Ranked> back(std::move(whole));
+        EXPECT_EQ(1, back->rank) << ERROR_EQUALITY;
+        EXPECT_FALSE(weak.expired()) << ERROR_FUNC;
+    }
+    EXPECT_EQ(1, CountedObject::destroyed) << ERROR_FUNC;
+
+    static_assert(sizeof(linked_ptr<TestObject>) == 4 * sizeof(void*),
+        "owner is a pointer, two links and the deleter");
+    static_assert(sizeof(weak_linked_ptr<TestObject>) == 4 * sizeof(void*),
+        "weak pointer is a pointer, two links and the deleter");
+
+    cout << "Custom deleters successful" << endl;
+}
+
+struct TreeNode
+{
+    linked_ptr<TreeNode> child;
+    weak_linked_ptr<TreeNode> parent;
+};
+
+TEST_F(Linked_Ptr_General_Tests, WeakPointers)
+{
+    cout << "TEST weak_linked_ptr" << endl;
+
+    cout << "Empty weak pointer" << endl;
+    {
+        weak_linked_ptr<TestObject> weakObj;
+        EXPECT_TRUE(weakObj.expired()) << ERROR_FUNC;
+        EXPECT_EQ(0, weakObj.use_count()) << ERROR_USE_COUNT;
+        EXPECT_EQ(nullptr, weakObj.lock().get()) << ERROR_FUNC;
+        linked_ptr<TestObject> linkedObj;
+        weak_linked_ptr<TestObject> weakFromEmpty(linkedObj);
+        EXPECT_TRUE(weakFromEmpty.expired()) << ERROR_FUNC;
+        weak_linked_ptr<TestObject> emptyCopy(weakObj);
+        EXPECT_TRUE(emptyCopy.expired()) << ERROR_FUNC;
+        EXPECT_EQ(nullptr, emptyCopy.lock().get()) << ERROR_FUNC;
+
+        linked_ptr<TestObject> owner(new TestObject(hello));
+        weak_linked_ptr<TestObject> emptyAssigned(owner);
+        emptyAssigned = weakObj;
+        EXPECT_TRUE(emptyAssigned.expired()) << ERROR_FUNC;
+        EXPECT_EQ(nullptr, emptyAssigned.lock().get()) << ERROR_FUNC;
+        emptyAssigned = linkedObj;
+        EXPECT_TRUE(emptyAssigned.expired()) << ERROR_FUNC;
+        EXPECT_TRUE(owner.unique()) << ERROR_UNIQUE;
+    }
+
+    cout << "Weak pointer does not own the object" << endl;
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<CountedObject> linkedObj(new CountedObject);
+        weak_linked_ptr<CountedObject> weakObj(linkedObj);
+        weak_linked_ptr<CountedObject> weakObjCopy(weakObj);
+        EXPECT_TRUE(linkedObj.unique()) << ERROR_UNIQUE;
+        EXPECT_EQ(1, linkedObj.use_count()) << ERROR_USE_COUNT;
+        EXPECT_EQ(1, weakObj.use_count()) << ERROR_USE_COUNT;
+        EXPECT_FALSE(weakObjCopy.expired()) << ERROR_FUNC;
+
+        linked_ptr<CountedObject> locked = weakObjCopy.lock();
+        EXPECT_EQ(linkedObj, locked) << ERROR_EQUALITY;
+        EXPECT_EQ(2, linkedObj.use_count()) << ERROR_USE_COUNT;
+        EXPECT_EQ(2, weakObj.use_count()) << ERROR_USE_COUNT;
+
+        linkedObj.reset();
+        EXPECT_FALSE(weakObj.expired()) << ERROR_FUNC;
+        EXPECT_TRUE(locked.unique()) << ERROR_UNIQUE;
+        locked.reset();
+        EXPECT_EQ(1, CountedObject::destroyed) << ERROR_FUNC;
+        EXPECT_TRUE(weakObj.expired()) << ERROR_FUNC;
+        EXPECT_TRUE(weakObjCopy.expired()) << ERROR_FUNC;
+        EXPECT_EQ(0, weakObj.use_count()) << ERROR_USE_COUNT;
+        EXPECT_EQ(nullptr, weakObj.lock().get()) << ERROR_FUNC;
+
+        weak_linked_ptr<CountedObject> weakFromExpired(weakObj);
+        EXPECT_TRUE(weakFromExpired.expired()) << ERROR_FUNC;
+    }
+    EXPECT_EQ(1, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Move, assignment and swap" << endl;
+    {
+        linked_ptr<TestObject> first(new TestObject(hello));
+        linked_ptr<TestObject> second(new TestObject(goodbye));
+        weak_linked_ptr<TestObject> weakFirst(first);
+        weak_linked_ptr<TestObject> weakSecond;
+        weakSecond = second;
+        weak_linked_ptr<TestObject> moved(std::move(weakFirst));
+        EXPECT_TRUE(weakFirst.expired()) << ERROR_FUNC;
+        EXPECT_EQ(hello, moved.lock()->msg) << ERROR_EQUALITY;
+        moved.swap(weakSecond);
+        EXPECT_EQ(goodbye, moved.lock()->msg) << ERROR_EQUALITY;
+        EXPECT_EQ(hello, weakSecond.lock()->msg) << ERROR_EQUALITY;
+        weakFirst = moved;
+        first.reset();
+        EXPECT_TRUE(weakSecond.expired()) << ERROR_FUNC;
+        EXPECT_FALSE(weakFirst.expired()) << ERROR_FUNC;
+        EXPECT_EQ(1, weakFirst.use_count()) << ERROR_USE_COUNT;
+    }
+
+    cout << "Weak pointer to the base" << endl;
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<CountedObjectDerive> derived(new CountedObjectDerive(hello));
+        weak_linked_ptr<CountedObject> weakBase(derived);
+        linked_ptr<CountedObject> base = weakBase.lock();
+        derived.reset();
+        EXPECT_EQ(0, CountedObject::destroyed) << ERROR_FUNC;
+    }
+    EXPECT_EQ(2, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Parent pointers don't keep the tree alive" << endl;
+    {
+        weak_linked_ptr<TreeNode> weakRoot;
+        weak_linked_ptr<TreeNode> weakLeaf;
+        {
+            linked_ptr<TreeNode> root(new TreeNode);
+            root->child.reset(new TreeNode);
+            root->child->parent = root;
+            weakRoot = root;
+            weakLeaf = root->child;
+            EXPECT_EQ(root, root->child->parent.lock()) << ERROR_EQUALITY;
+        }
+        EXPECT_TRUE(weakRoot.expired()) << ERROR_FUNC;
+        EXPECT_TRUE(weakLeaf.expired()) << ERROR_FUNC;
+    }
+
+    cout << "weak_linked_ptr successful" << endl;
+}
+
+TEST_F(Linked_Ptr_General_Tests, DestroyRange)
+{
+    cout << "TEST destroy_range" << endl;
+
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<CountedObject> outside(new CountedObject);
+        linked_ptr<CountedObject> shared(new CountedObject);
+        weak_linked_ptr<CountedObject> weakShared(shared);
+        weak_linked_ptr<CountedObject> weakOutside(outside);
+        std::vector<linked_ptr<CountedObject>> vp;
+        for (int i = 0; i < MAX_ITERATIONS; ++i)
+        {
+            switch (i % 4)
+            {
+            case 0: vp.push_back(linked_ptr<CountedObject>(new CountedObject)); break;
+            case 1: vp.push_back(shared); break;
+            case 2: vp.push_back(outside); break;
+            default: vp.push_back(linked_ptr<CountedObject>()); break;
+            }
+        }
+            // neighbours in the ring are neighbours in the range too
+        vp.push_back(vp.back());
+        vp.push_back(vp[1]);
+        vp.push_back(vp[1]);
+        shared.reset();
+        EXPECT_EQ(0, CountedObject::destroyed) << ERROR_FUNC;
+
+        destroy_range(vp.data(), vp.data() + vp.size());
+        EXPECT_EQ(MAX_ITERATIONS / 4 + 1, CountedObject::destroyed) << ERROR_FUNC;
+        EXPECT_TRUE(weakShared.expired()) << ERROR_FUNC;
+        EXPECT_FALSE(weakOutside.expired()) << ERROR_FUNC;
+        EXPECT_TRUE(outside.unique()) << ERROR_UNIQUE;
+        for (linked_ptr<CountedObject> const& ptr : vp)
+        {
+            EXPECT_EQ(nullptr, ptr.get()) << ERROR_FUNC;
+            EXPECT_TRUE(ptr.unique()) << ERROR_UNIQUE;
+        }
+        vp.clear();
+        EXPECT_EQ(MAX_ITERATIONS / 4 + 1, CountedObject::destroyed) << ERROR_FUNC;
+
+        cout << "Range in the middle of a ring" << endl;
+        for (int i = 0; i < 10; ++i)
+            vp.push_back(outside);
+        linked_ptr<CountedObject> behind(outside);
+        destroy_range(vp.data() + 2, vp.data() + 8);
+        EXPECT_EQ(6, outside.use_count()) << ERROR_USE_COUNT;
+        EXPECT_EQ(outside, vp[9]) << ERROR_EQUALITY;
+        EXPECT_EQ(nullptr, vp[5].get()) << ERROR_FUNC;
+        vp.clear();
+        behind.reset();
+        EXPECT_TRUE(outside.unique()) << ERROR_UNIQUE;
+    }
+    EXPECT_EQ(MAX_ITERATIONS / 4 + 2, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "destroy_range successful" << endl;
+}
+
+struct Record : public CountedObject
+{
+    Record(int i, char const* message)
+        : id(i)
+        , name(message)
+    {
+    }
+    int id;
+    std::string name;
+};
+
+TEST_F(Linked_Ptr_General_Tests, Aliasing)
+{
+    cout << "TEST aliasing constructor" << endl;
+
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<std::string> name;
+        {
+            linked_ptr<Record> record = make_linked<Record>(1, hello);
+            linked_ptr<int> id(record, &record->id);
+            name = linked_ptr<std::string>(record, &record->name);
+            EXPECT_EQ(1, *id) << ERROR_EQUALITY;
+            EXPECT_EQ(3, record.use_count()) << ERROR_USE_COUNT;
+            EXPECT_EQ(3, name.use_count()) << ERROR_USE_COUNT;
+        }
+        EXPECT_EQ(0, CountedObject::destroyed) << ERROR_FUNC;
+        EXPECT_TRUE(name.unique()) << ERROR_UNIQUE;
+        EXPECT_EQ(std::string(hello), *name) << ERROR_EQUALITY;
+
+        cout << "Aliases keep their view through copies, moves and weak pointers" << endl;
+        linked_ptr<std::string> copy(name);
+        weak_linked_ptr<std::string> weakName(copy);
+        linked_ptr<std::string> moved(std::move(copy));
+        EXPECT_EQ(std::string(hello), *weakName.lock()) << ERROR_EQUALITY;
+        EXPECT_EQ(name, moved) << ERROR_EQUALITY;
+        EXPECT_EQ(2, moved.use_count()) << ERROR_USE_COUNT;
+
+        cout << "Alias from an rvalue takes the owner's place" << endl;
+        linked_ptr<Record> other(new Record(2, goodbye));
+        linked_ptr<int> otherId(std::move(other), &other->id);
+        EXPECT_EQ(nullptr, other.get()) << ERROR_FUNC;
+        EXPECT_TRUE(otherId.unique()) << ERROR_UNIQUE;
+        EXPECT_EQ(2, *otherId) << ERROR_EQUALITY;
+
+        cout << "Same address, different owners" << endl;
+        static int shared = 0;
+        linked_ptr<int> first(linked_ptr<Record>(new Record(3, hello)), &shared);
+        linked_ptr<int> second(otherId, &shared);
+        first = second;
+        EXPECT_EQ(1, CountedObject::destroyed) << ERROR_FUNC;
+        EXPECT_EQ(3, otherId.use_count()) << ERROR_USE_COUNT;
+    }
+    EXPECT_EQ(3, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Aliasing constructor successful" << endl;
+}
+
+template<class P, class S, class = void>
+struct can_reset : std::false_type
+{
+};
+
+template<class P, class S>
+struct can_reset<P, S, decltype(std::declval<P&>().reset(std::declval<S*>()))> : std::true_type
+{
+};
+
+template<class P, class = void>
+struct has_subscript : std::false_type
+{
+};
+
+template<class P>
+struct has_subscript<P, decltype((void)std::declval<P&>()[0])> : std::true_type
+{
+};
+
+template<class P, class = void>
+struct has_arrow : std::false_type
+{
+};
+
+template<class P>
+struct has_arrow<P, decltype((void)std::declval<P&>().operator->())> : std::true_type
+{
+};
+
+TEST_F(Linked_Ptr_General_Tests, Arrays)
+{
+    cout << "TEST array pointers" << endl;
+
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<CountedObject[]> objects(new CountedObject[4]);
+        linked_ptr<CountedObject[]> copy(objects);
+        EXPECT_EQ(&objects[2], copy.get() + 2) << ERROR_EQUALITY;
+        EXPECT_EQ(2, copy.use_count()) << ERROR_USE_COUNT;
+        objects.reset();
+        EXPECT_EQ(0, CountedObject::destroyed) << ERROR_FUNC;
+    }
+    EXPECT_EQ(4, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Arrays from make_linked are value-initialized" << endl;
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<int[]> buffer = make_linked<int[]>(64);
+        for (std::size_t i = 0; i < 64; ++i)
+            EXPECT_EQ(0, buffer[i]) << ERROR_EQUALITY;
+        buffer[7] = 7;
+        linked_ptr<int[]> const other(buffer);
+        EXPECT_EQ(7, other[7]) << ERROR_EQUALITY;
+
+        linked_ptr<CountedObject[]> objects = make_linked<CountedObject[]>(5);
+        linked_ptr<CountedObject> third(objects, &objects[2]);
+        objects.reset();
+        EXPECT_EQ(0, CountedObject::destroyed) << ERROR_FUNC;
+        EXPECT_TRUE(third.unique()) << ERROR_UNIQUE;
+    }
+    EXPECT_EQ(5, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Arrays from unique_ptr keep delete[]" << endl;
+    CountedObject::destroyed = 0;
+    {
+        std::unique_ptr<CountedObject[]> unique(new CountedObject[3]);
+        linked_ptr<CountedObject[]> objects(std::move(unique));
+        weak_linked_ptr<CountedObject[]> weak(objects);
+        EXPECT_EQ(objects, weak.lock()) << ERROR_EQUALITY;
+    }
+    EXPECT_EQ(3, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Arrays take their own element type only" << endl;
+    static_assert(std::is_constructible<linked_ptr<CountedObject const[]>, CountedObject*>::value,
+        "array of const elements from mutable ones");
+    static_assert(!std::is_constructible<linked_ptr<CountedObject[]>, CountedObjectDerive*>::value,
+        "array from derived elements");
+    static_assert(!std::is_constructible<linked_ptr<CountedObject[]>, CountedObjectDerive*, std::default_delete<CountedObject[]>>::value,
+        "array from derived elements with a deleter");
+    static_assert(can_reset<linked_ptr<CountedObject[]>, CountedObject>::value, "array reset");
+    static_assert(!can_reset<linked_ptr<CountedObject[]>, CountedObjectDerive>::value, "array reset to derived elements");
+    static_assert(can_reset<linked_ptr<CountedObject>, CountedObjectDerive>::value, "object reset to a derived one");
+    static_assert(has_subscript<linked_ptr<int[]>>::value && !has_subscript<linked_ptr<int>>::value,
+        "operator[] for arrays only");
+    static_assert(has_arrow<linked_ptr<Record>>::value && !has_arrow<linked_ptr<Record[]>>::value,
+        "operator-> for single objects only");
+
+    cout << "Array pointers successful" << endl;
+}
+
+    // hands out owning pointers to itself to the callbacks it registers
+struct Session : public CountedObject, public enable_linked_from_this<Session>
+{
+    void subscribe(std::vector<std::function<int()>>& callbacks)
+    {
+        linked_ptr<Session> self = linked_from_this();
+        callbacks.push_back([self]() { return self->id; });
+    }
+
+    int id{ 42 };
+};
+
+TEST_F(Linked_Ptr_General_Tests, LinkedFromThis)
+{
+    cout << "TEST linked pointers from this" << endl;
+
+    CountedObject::destroyed = 0;
+    std::vector<std::function<int()>> callbacks;
+    {
+        linked_ptr<Session> session(new Session);
+        session->subscribe(callbacks);
+        session->subscribe(callbacks);
+        EXPECT_EQ(3, session.use_count()) << ERROR_USE_COUNT;
+        EXPECT_EQ(session, session->linked_from_this()) << ERROR_EQUALITY;
+    }
+    EXPECT_EQ(0, CountedObject::destroyed) << ERROR_FUNC;
+    EXPECT_EQ(42, callbacks.front()()) << ERROR_EQUALITY;
+    callbacks.clear();
+    EXPECT_EQ(1, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Objects from make_linked share their ring" << endl;
+    {
+        linked_ptr<Session const> session = make_linked<Session>();
+        linked_ptr<Session const> self = session->linked_from_this();
+        EXPECT_EQ(2, session.use_count()) << ERROR_USE_COUNT;
+        weak_linked_ptr<Session const> weak = session->weak_from_this();
+        session.reset();
+        self.reset();
+        EXPECT_TRUE(weak.expired()) << ERROR_FUNC;
+    }
+    EXPECT_EQ(2, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Objects without owners give empty pointers" << endl;
+    {
+        Session local;
+        EXPECT_EQ(nullptr, local.linked_from_this().get()) << ERROR_FUNC;
+        weak_linked_ptr<Session> weakLocal = local.weak_from_this();
+        EXPECT_TRUE(weakLocal.expired()) << ERROR_FUNC;
+        EXPECT_EQ(nullptr, weakLocal.lock().get()) << ERROR_FUNC;
+        linked_ptr<Session> owner(new Session(local));
+        EXPECT_EQ(owner, owner->linked_from_this()) << ERROR_EQUALITY;
+        EXPECT_EQ(nullptr, local.linked_from_this().get()) << ERROR_FUNC;
+        EXPECT_TRUE(local.weak_from_this().expired()) << ERROR_FUNC;
+        EXPECT_FALSE(owner->weak_from_this().expired()) << ERROR_FUNC;
+        owner.reset(new Session);
+        EXPECT_EQ(2, owner->linked_from_this().use_count()) << ERROR_USE_COUNT;
+    }
+    EXPECT_EQ(5, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Linked pointers from this successful" << endl;
+}
+
+    // request pipeline passing the object down by view,
+    // the last stage keeps it
+static int pipeline_stage(borrowed_linked_ptr<CountedObject> object, int depth, std::vector<linked_ptr<CountedObject>>& kept)
+{
+    if (depth == 0)
+    {
+        kept.push_back(object.share());
+        return 0;
+    }
+    return 1 + pipeline_stage(object, depth - 1, kept);
+}
+
+TEST_F(Linked_Ptr_General_Tests, Borrowed)
+{
+    cout << "TEST borrowed pointers" << endl;
+
+    static_assert(std::is_trivially_copyable<borrowed_linked_ptr<CountedObject>>::value, "borrowed_linked_ptr isn't trivially copyable");
+
+    CountedObject::destroyed = 0;
+    std::vector<linked_ptr<CountedObject>> kept;
+    {
+        linked_ptr<CountedObjectDerive> owner(new CountedObjectDerive(hello));
+        borrowed_linked_ptr<CountedObjectDerive> view(owner);
+        borrowed_linked_ptr<CountedObject> base(view);
+        EXPECT_EQ(owner.get(), base.get()) << ERROR_EQUALITY;
+        EXPECT_TRUE(owner.unique()) << ERROR_UNIQUE;
+
+        EXPECT_EQ(8, pipeline_stage(owner, 8, kept)) << ERROR_FUNC;
+        EXPECT_EQ(2, owner.use_count()) << ERROR_USE_COUNT;
+        linked_ptr<CountedObjectDerive> shared = view.share();
+        EXPECT_EQ(3, owner.use_count()) << ERROR_USE_COUNT;
+        EXPECT_EQ(owner, shared) << ERROR_EQUALITY;
+    }
+    EXPECT_EQ(0, CountedObject::destroyed) << ERROR_FUNC;
+    EXPECT_TRUE(kept.front().unique()) << ERROR_UNIQUE;
+    kept.clear();
+        // both destructors count
+    EXPECT_EQ(2, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Empty pointers give empty views" << endl;
+    linked_ptr<CountedObject> empty;
+    borrowed_linked_ptr<CountedObject> view(empty);
+    EXPECT_FALSE(view) << ERROR_FUNC;
+    EXPECT_EQ(nullptr, view.share().get()) << ERROR_FUNC;
+
+    cout << "Borrowed pointers successful" << endl;
+}
+
+    // messages dispatched by their dynamic type
+struct Message : public CountedObject
+{
+    virtual ~Message() {}
+};
+
+struct Ping : public Message
+{
+    int sequence{ 7 };
+};
+
+TEST_F(Linked_Ptr_General_Tests, Casts)
+{
+    cout << "TEST linked casts" << endl;
+
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<Message> message(new Ping);
+        linked_ptr<Ping> ping = static_linked_cast<Ping>(message);
+        EXPECT_EQ(7, ping->sequence) << ERROR_EQUALITY;
+        EXPECT_EQ(2, message.use_count()) << ERROR_USE_COUNT;
+
+        linked_ptr<Ping> dynamicPing = dynamic_linked_cast<Ping>(message);
+        EXPECT_EQ(ping, dynamicPing) << ERROR_EQUALITY;
+        EXPECT_EQ(3, message.use_count()) << ERROR_USE_COUNT;
+
+        linked_ptr<Message> plain(new Message);
+        EXPECT_EQ(nullptr, dynamic_linked_cast<Ping>(plain).get()) << ERROR_FUNC;
+        EXPECT_TRUE(plain.unique()) << ERROR_UNIQUE;
+
+        linked_ptr<Ping const> constPing(ping);
+        linked_ptr<Ping> mutablePing = const_linked_cast<Ping>(constPing);
+        mutablePing->sequence = 8;
+        EXPECT_EQ(8, ping->sequence) << ERROR_EQUALITY;
+
+        linked_ptr<char> bytes = reinterpret_linked_cast<char>(ping);
+        EXPECT_EQ(reinterpret_cast<char*>(ping.get()), bytes.get()) << ERROR_EQUALITY;
+        EXPECT_EQ(6, message.use_count()) << ERROR_USE_COUNT;
+    }
+    EXPECT_EQ(2, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Rvalue casts take the source's place" << endl;
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<Message> message(new Ping);
+        linked_ptr<Message> other(message);
+        linked_ptr<Ping> ping = static_linked_cast<Ping>(std::move(message));
+        EXPECT_EQ(nullptr, message.get()) << ERROR_FUNC;
+        EXPECT_EQ(2, ping.use_count()) << ERROR_USE_COUNT;
+
+        linked_ptr<Ping> failed = dynamic_linked_cast<Ping>(linked_ptr<Message>(new Message));
+        EXPECT_EQ(nullptr, failed.get()) << ERROR_FUNC;
+        EXPECT_EQ(1, CountedObject::destroyed) << ERROR_FUNC;
+
+        linked_ptr<Message> back = dynamic_linked_cast<Message>(std::move(ping));
+        EXPECT_EQ(nullptr, ping.get()) << ERROR_FUNC;
+        EXPECT_EQ(other, back) << ERROR_EQUALITY;
+        EXPECT_EQ(2, other.use_count()) << ERROR_USE_COUNT;
+    }
+    EXPECT_EQ(2, CountedObject::destroyed) << ERROR_FUNC;
+
+    cout << "Linked casts successful" << endl;
+}
+
+TEST_F(Linked_Ptr_General_Tests, HeterogeneousLookup)
+{
+    cout << "TEST comparisons and lookups without temporaries" << endl;
+
+    linked_ptr<TestObject> empty;
+    EXPECT_TRUE(empty == nullptr) << ERROR_EQUALITY;
+    EXPECT_TRUE(nullptr != r_tod) << ERROR_INEQUALITY;
+    EXPECT_TRUE(r_tod == r_tod.get()) << ERROR_EQUALITY;
+    EXPECT_TRUE(s_tod.get() != r_tod) << ERROR_INEQUALITY;
+    {
+        linked_ptr<TestObject const> constant(r_tod);
+        EXPECT_TRUE(constant == r_tod) << ERROR_EQUALITY;
+    }
+    EXPECT_EQ(r_tod < s_tod, r_tod.get() < s_tod) << ERROR_LESS;
+
+    cout << "Find and erase by raw pointer" << endl;
+    std::set<linked_ptr<TestObject>, linked_ptr_less> sp;
+    sp.insert(r_tod);
+    sp.insert(s_tod);
+    EXPECT_EQ(2, r_tod.use_count()) << ERROR_USE_COUNT;
+    TestObject* raw = r_tod.get();
+    EXPECT_FALSE(sp.find(raw) == sp.end()) << ERROR_NOT_FOUND;
+    EXPECT_FALSE(sp.find(s_tod) == sp.end()) << ERROR_NOT_FOUND;
+    EXPECT_EQ(2, r_tod.use_count()) << ERROR_USE_COUNT;
+    sp.erase(sp.find(raw));
+    EXPECT_TRUE(sp.find(raw) == sp.end()) << ERROR_FOUND;
+    EXPECT_TRUE(r_tod.unique()) << ERROR_UNIQUE;
+
+    cout << "Owner order puts aliases together" << endl;
+    linked_ptr<Record> record = make_linked<Record>(1, hello);
+    linked_ptr<int> id(record, &record->id);
+    linked_ptr<std::string> name(record, &record->name);
+    weak_linked_ptr<int> weakId(id);
+    EXPECT_FALSE(id.owner_before(name) || name.owner_before(id)) << ERROR_LESS;
+    EXPECT_FALSE(weakId.owner_before(record) || record.owner_before(weakId)) << ERROR_LESS;
+    EXPECT_TRUE(id.owner_before(r_tod) || r_tod.owner_before(id)) << ERROR_LESS;
+
+    cout << "Comparisons and lookups without temporaries successful" << endl;
+}
@@ -0,0 +1,208 @@
+#include <vector>
+#include "linked_ptr.h"
+#include "counted_linked_ptr.h"
+#include "concurrent_linked_ptr.h"
+#include "intrusive_linked_ptr.h"
+#include "biased_linked_ptr.h"
+
+using std::cout;
+using std::endl;
+
+struct no_hook
+{
+};
+
+    // object owned by the handles under test, counts its destructions.
+    // Hook is linked_hook for the intrusive handles
+template<class Hook>
+class HandleObject : public Hook
+{
+public:
+    static int destroyed;
+    HandleObject(int v = 0): value(v)
+    {
+    }
+    virtual ~HandleObject()
+    {
+        ++destroyed;
+    }
+    int value;
+};
+
+template<class Hook>
+int HandleObject<Hook>::destroyed = 0;
+
+template<class Hook>
+class HandleObjectDerive : public HandleObject<Hook>
+{
+public:
+    HandleObjectDerive(int v): HandleObject<Hook>(v)
+    {
+    }
+};
+
+    // family of handles: ptr<T> owns a T, its objects derive from hook
+struct linked_handles
+{
+    template<class T> using ptr = linked_ptr<T>;
+    typedef no_hook hook;
+};
+
+struct counted_handles
+{
+    template<class T> using ptr = counted_linked_ptr<T>;
+    typedef no_hook hook;
+};
+
+struct concurrent_handles
+{
+    template<class T> using ptr = concurrent_linked_ptr<T>;
+    typedef no_hook hook;
+};
+
+struct intrusive_handles
+{
+    template<class T> using ptr = intrusive_linked_ptr<T>;
+    typedef linked_hook hook;
+};
+
+struct biased_handles
+{
+    template<class T> using ptr = biased_linked_ptr<T>;
+    typedef no_hook hook;
+};
+
+    // object holding the next owner of a chain
+template<class F>
+struct HandleChain : public HandleObject<typename F::hook>
+{
+    typename F::template ptr<HandleChain<F>> next;
+};
+
+template<class F>
+class Handle_Tests : public ::testing::Test
+{
+protected:
+    typedef HandleObject<typename F::hook> object_type;
+    typedef HandleObjectDerive<typename F::hook> derived_type;
+    typedef typename F::template ptr<object_type> object_ptr;
+    typedef typename F::template ptr<derived_type> derived_ptr;
+    typedef HandleChain<F> chain_type;
+    typedef typename F::template ptr<chain_type> chain_ptr;
+
+    int const MAX_ITERATIONS;
+
+public:
+    Handle_Tests()
+        : MAX_ITERATIONS(1000)
+    {
+        object_type::destroyed = 0;
+    }
+};
+
+typedef ::testing::Types<linked_handles, counted_handles, concurrent_handles,
+    intrusive_handles, biased_handles> handle_families;
+TYPED_TEST_CASE(Handle_Tests, handle_families);
+
+TYPED_TEST(Handle_Tests, Use_count)
+{
+    cout << "TEST handle use_count" << endl;
+
+    typedef typename TestFixture::object_type object_type;
+    typedef typename TestFixture::object_ptr object_ptr;
+    {
+        object_ptr ptr(new object_type(1));
+        EXPECT_TRUE(ptr.unique());
+        EXPECT_EQ(1, ptr.use_count());
+
+        std::vector<object_ptr> owners;
+        for (int i = 0; i < this->MAX_ITERATIONS; ++i)
+        {
+            owners.push_back(ptr);
+            EXPECT_FALSE(ptr.unique());
+        }
+        EXPECT_EQ(this->MAX_ITERATIONS + 1, ptr.use_count());
+            // drop owners from the middle of the ring
+        while (!owners.empty())
+        {
+            owners.erase(owners.begin() + owners.size() / 2);
+            EXPECT_EQ(static_cast<long>(owners.size()) + 1, ptr.use_count());
+        }
+        EXPECT_TRUE(ptr.unique());
+        EXPECT_EQ(0, object_type::destroyed);
+    }
+    EXPECT_EQ(1, object_type::destroyed);
+
+    object_ptr emptyPtr;
+    EXPECT_EQ(0, emptyPtr.use_count());
+    object_ptr emptyCopy(emptyPtr);
+    EXPECT_EQ(0, emptyCopy.use_count());
+
+    cout << "Handle use_count successful" << endl;
+}
+
+TYPED_TEST(Handle_Tests, Conversion_swap_move)
+{
+    cout << "TEST handle conversion, swap and move" << endl;
+
+    typedef typename TestFixture::object_type object_type;
+    typedef typename TestFixture::derived_type derived_type;
+    typedef typename TestFixture::object_ptr object_ptr;
+    typedef typename TestFixture::derived_ptr derived_ptr;
+    {
+        derived_ptr derived(new derived_type(1));
+        object_ptr base(derived);
+        object_ptr other(new object_type(2));
+        object_ptr otherCopy(other);
+        EXPECT_EQ(2, derived.use_count());
+
+        base.swap(other);
+        EXPECT_EQ(2, base->value);
+        EXPECT_EQ(1, other->value);
+        EXPECT_EQ(2, base.use_count());
+        EXPECT_EQ(2, other.use_count());
+
+        object_ptr moved(std::move(other));
+        EXPECT_FALSE(other);
+        EXPECT_EQ(0, other.use_count());
+        EXPECT_EQ(2, moved.use_count());
+        derived.reset();
+        EXPECT_TRUE(moved.unique());
+
+        otherCopy = moved;
+        EXPECT_TRUE(base.unique());
+        EXPECT_EQ(2, moved.use_count());
+        base = std::move(moved);
+        EXPECT_EQ(1, object_type::destroyed);
+        EXPECT_EQ(1, base->value);
+        EXPECT_EQ(2, base.use_count());
+    }
+    EXPECT_EQ(2, object_type::destroyed);
+
+    cout << "Handle conversion, swap and move successful" << endl;
+}
+
+TYPED_TEST(Handle_Tests, Assignment_from_released_object)
+{
+    cout << "TEST handle assignment from inside the released object" << endl;
+
+    typedef typename TestFixture::object_type object_type;
+    typedef typename TestFixture::chain_type chain_type;
+    typedef typename TestFixture::chain_ptr chain_ptr;
+
+    chain_ptr head(new chain_type);
+    head->next = chain_ptr(new chain_type);
+    head->next->next = chain_ptr(new chain_type);
+    head->next->next->next = chain_ptr(new chain_type);
+        // the source lives inside the object the target releases
+    head = head->next;
+    EXPECT_EQ(1, object_type::destroyed);
+    head = std::move(head->next);
+    EXPECT_EQ(2, object_type::destroyed);
+    EXPECT_TRUE(head.unique());
+    while (head)
+        head = std::move(head->next);
+    EXPECT_EQ(4, object_type::destroyed);
+
+    cout << "Handle assignment from inside the released object successful" << endl;
+}
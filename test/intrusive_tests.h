@@ -0,0 +1,58 @@
+#include "intrusive_linked_ptr.h"
+#include "TestObject.h"
+
+using std::cout;
+using std::endl;
+
+class HookedObject : public linked_hook
+{
+public:
+    static int destroyed;
+    HookedObject(int v): value(v)
+    {
+    }
+    virtual ~HookedObject()
+    {
+        ++destroyed;
+    }
+    int value;
+};
+
+int HookedObject::destroyed = 0;
+
+class Intrusive_Linked_Ptr_Tests : public ::testing::Test
+{
+public:
+    Intrusive_Linked_Ptr_Tests()
+    {
+        HookedObject::destroyed = 0;
+    }
+};
+
+TEST_F(Intrusive_Linked_Ptr_Tests, Raw_pointer_joins_ring)
+{
+    cout << "TEST intrusive handle from a raw pointer" << endl;
+
+    static_assert(sizeof(intrusive_linked_ptr<HookedObject>) == 3 * sizeof(void*),
+        "intrusive handle is a pointer and two links");
+    intrusive_linked_ptr<HookedObject> empty;
+    EXPECT_FALSE(empty.unique());
+    {
+        intrusive_linked_ptr<HookedObject> ptr(new HookedObject(2));
+        HookedObject* raw = ptr.get();
+        intrusive_linked_ptr<HookedObject> other(raw);
+        EXPECT_EQ(ptr, other);
+        EXPECT_EQ(2, ptr.use_count());
+        ptr.reset();
+        EXPECT_EQ(0, HookedObject::destroyed);
+        EXPECT_TRUE(other.unique());
+
+            // a copy of the object is not owned by anyone
+        HookedObject copy(*other);
+        EXPECT_EQ(2, copy.value);
+        EXPECT_TRUE(other.unique());
+    }
+    EXPECT_EQ(2, HookedObject::destroyed);
+
+    cout << "Intrusive handle from a raw pointer successful" << endl;
+}
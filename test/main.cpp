@@ -3,6 +3,17 @@
 #include <memory>
 #include "gtest/gtest.h"
 #include "general_tests.h"
+#include "handle_tests.h"
+#include "counted_tests.h"
+#include "concurrent_tests.h"
+#include "intrusive_tests.h"
+#include "compact_tests.h"
+#include "reclamation_tests.h"
+#include "epoch_tests.h"
+#include "atomic_tests.h"
+#include "buffer_tests.h"
+#include "biased_tests.h"
+#include "flat_tests.h"
 #include "linked_ptr.h"
 
 using std::shared_ptr;
@@ -0,0 +1,137 @@
+#include <thread>
+#include <vector>
+#include "linked_ptr.h"
+#include "reclamation_queue.h"
+#include "TestObject.h"
+
+using std::cout;
+using std::endl;
+
+class Reclamation_Queue_Tests : public ::testing::Test
+{
+protected:
+    int const MAX_ITERATIONS;
+
+public:
+    Reclamation_Queue_Tests()
+        : MAX_ITERATIONS(10000)
+    {
+        CountedObject::destroyed = 0;
+    }
+};
+
+    // chain of objects, every link is released into the same queue
+struct DeferredChain : public CountedObject
+{
+    linked_ptr<DeferredChain> next;
+};
+
+TEST_F(Reclamation_Queue_Tests, Drain)
+{
+    cout << "TEST objects destroyed on drain" << endl;
+
+    reclamation_queue queue;
+    {
+        linked_ptr<CountedObject> ptr(new CountedObject, deferred_delete<CountedObject>(queue));
+        linked_ptr<CountedObject> copy(ptr);
+        ptr.reset();
+        copy.reset();
+        EXPECT_EQ(0, CountedObject::destroyed);
+        EXPECT_EQ(1u, queue.stats().depth);
+    }
+    EXPECT_EQ(1u, queue.drain());
+    EXPECT_EQ(1, CountedObject::destroyed);
+
+    cout << "Destructors queue more objects" << endl;
+    CountedObject::destroyed = 0;
+    {
+        linked_ptr<DeferredChain> head(new DeferredChain, deferred_delete<DeferredChain>(queue));
+        DeferredChain* tail = head.get();
+        for (int i = 0; i < 10; ++i)
+        {
+            tail->next = linked_ptr<DeferredChain>(new DeferredChain, deferred_delete<DeferredChain>(queue));
+            tail = tail->next.get();
+        }
+    }
+    EXPECT_EQ(0, CountedObject::destroyed);
+    EXPECT_EQ(11u, queue.drain());
+    EXPECT_EQ(11, CountedObject::destroyed);
+
+    reclamation_stats const stats = queue.stats();
+    EXPECT_EQ(0u, stats.depth);
+    EXPECT_EQ(12u, stats.enqueued);
+    EXPECT_EQ(12u, stats.reclaimed);
+    EXPECT_EQ(0u, stats.overflows);
+
+    cout << "Objects destroyed on drain successful" << endl;
+}
+
+TEST_F(Reclamation_Queue_Tests, Bounded)
+{
+    cout << "TEST full queue destroys in place" << endl;
+
+    {
+        reclamation_queue queue(2);
+        for (int i = 0; i < 3; ++i)
+            linked_ptr<CountedObject>(new CountedObject, deferred_delete<CountedObject>(queue));
+        EXPECT_EQ(1, CountedObject::destroyed);
+
+        reclamation_stats const stats = queue.stats();
+        EXPECT_EQ(2u, stats.depth);
+        EXPECT_EQ(2u, stats.peakDepth);
+        EXPECT_EQ(1u, stats.overflows);
+    }
+    EXPECT_EQ(3, CountedObject::destroyed);
+
+    cout << "The batch being destroyed counts against the capacity" << endl;
+    CountedObject::destroyed = 0;
+    {
+        reclamation_queue queue(2);
+        {
+            linked_ptr<DeferredChain> head(new DeferredChain, deferred_delete<DeferredChain>(queue));
+            head->next = linked_ptr<DeferredChain>(new DeferredChain, deferred_delete<DeferredChain>(queue));
+            linked_ptr<CountedObject> other(new CountedObject, deferred_delete<CountedObject>(queue));
+        }
+        EXPECT_EQ(0, CountedObject::destroyed);
+            // head releases its next while the batch is in flight
+        EXPECT_EQ(2u, queue.drain());
+        EXPECT_EQ(3, CountedObject::destroyed);
+
+        reclamation_stats const stats = queue.stats();
+        EXPECT_EQ(0u, stats.depth);
+        EXPECT_EQ(2u, stats.peakDepth);
+        EXPECT_EQ(1u, stats.overflows);
+    }
+
+    cout << "Full queue destroys in place successful" << endl;
+}
+
+TEST_F(Reclamation_Queue_Tests, Background)
+{
+    cout << "TEST background reclamation" << endl;
+
+    reclamation_queue queue(MAX_ITERATIONS);
+    queue.start();
+    for (int i = 0; i < MAX_ITERATIONS; ++i)
+    {
+        linked_ptr<CountedObject> ptr(new CountedObject, deferred_delete<CountedObject>(queue));
+        linked_ptr<CountedObject> copy(ptr);
+    }
+    queue.stop();
+    EXPECT_EQ(MAX_ITERATIONS, CountedObject::destroyed);
+
+    reclamation_stats const stats = queue.stats();
+    EXPECT_EQ(static_cast<unsigned long long>(MAX_ITERATIONS), stats.reclaimed);
+    EXPECT_LE(stats.lastDrain.count(), stats.longestDrain.count());
+
+    cout << "Stopped from several threads" << endl;
+    queue.start();
+    std::vector<std::thread> stoppers;
+    for (int t = 0; t < 4; ++t)
+        stoppers.emplace_back([&queue]() { queue.stop(); });
+    for (std::thread& stopper : stoppers)
+        stopper.join();
+    queue.start();
+
+    cout << "Background reclamation successful" << endl;
+}